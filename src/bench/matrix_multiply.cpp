@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "../geometry/core.hpp"
+
+/**
+ * Matrix product micro-benchmark, built with -DCPP_ENGINE_BENCHMARKS=ON.
+ * Compares the runtime-bounded triple loop the Matrix concept used to run with the unrolled and vector paths.
+ * */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto matrices = std::size_t{ 1024 };
+constexpr auto rounds = std::size_t{ 2000 };
+
+/* The former generic operator*, kept as the baseline */
+template <class T>
+auto loop_product(T const& left, T const& right) -> T {
+    auto product = T{};
+
+    for (auto i = 0u; i < std::size(product); ++i) {
+        for (auto j = 0u; j < std::size(product); ++j) {
+            for (auto k = 0u; k < std::size(product); ++k) {
+                product[i][j] += left[i][k] * right[k][j];
+            }
+        }
+    }
+
+    return product;
+}
+
+template <class M>
+auto random_matrices(std::mt19937 & rng) -> std::vector<M> {
+    auto value = std::uniform_real_distribution<double>{ -1.0, 1.0 };
+    auto out = std::vector<M>(matrices);
+
+    for (auto& m : out) {
+        for (auto& row : m.container) {
+            for (auto& x : row) {
+                x = typename M::scalar_type(value(rng));
+            }
+        }
+    }
+
+    return out;
+}
+
+/* ns per product, the checksum keeps the products alive */
+template <class M, class Product>
+auto measure(std::vector<M> const& left, std::vector<M> const& right, Product && product) -> std::pair<double, double> {
+    auto checksum = 0.0;
+    auto start = Clock::now();
+
+    for (auto round = 0ul; round < rounds; ++round) {
+        for (auto i = 0ul; i < matrices; ++i) {
+            auto m = product(left[i], right[(i + round) % matrices]);
+            checksum += double(m.container[i % std::size(m.container)][round % std::size(m.container)]);
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    return { elapsed / double(rounds * matrices), checksum };
+}
+
+template <class M>
+auto compare(char const * name, std::mt19937 & rng) -> void {
+    auto left = random_matrices<M>(rng), right = random_matrices<M>(rng);
+
+    auto [ loop_ns, loop_sum ] = measure(left, right, [](M const& l, M const& r) { return loop_product(l, r); });
+    auto [ fast_ns, fast_sum ] = measure(left, right, [](M const& l, M const& r) { return l * r; });
+
+    fmt::print("{:<6} loop {:6.2f} ns  unrolled {:6.2f} ns  x{:.2f}  checksum {}\n",
+               name, loop_ns, fast_ns, loop_ns / fast_ns, loop_sum == fast_sum ? "equal" : "differs");
+}
+
+} // namespace
+
+/* Products of known matrices fold at compile time */
+static_assert((engine::Mat4::translate(1, 2, 3) * engine::Mat4::scale(2, 2, 2)).at(2, 3) == 3);
+static_assert((engine::Mat3::translate(1, 2) * engine::Mat3::translate(3, 4)).at(1, 2) == 6);
+
+auto main() -> int {
+    auto rng = std::mt19937{ 42 };
+
+    compare<engine::Mat3>("Mat3", rng);
+    compare<engine::Mat3f>("Mat3f", rng);
+    compare<engine::Mat4>("Mat4", rng);
+    compare<engine::Mat4f>("Mat4f", rng);
+}
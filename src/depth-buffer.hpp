@@ -0,0 +1,118 @@
+#ifndef CPP_ENGINE_DEPTH_BUFFER_HPP
+#define CPP_ENGINE_DEPTH_BUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "utility/accessors.hpp"
+
+namespace engine {
+
+/**
+ * Depth companion to Buffer_2D, smaller values are closer.
+ * Keeps a min/max pyramid level per tile so whole tiles can be accepted or rejected by a triangle.
+ * */
+template <class Depth_Type = float>
+struct Depth_Buffer : Accessors_For<Depth_Buffer<Depth_Type>> {
+    using Depth_Container = std::vector<Depth_Type>;
+
+    static constexpr std::size_t tile_size = 8;
+    static constexpr Depth_Type far = std::numeric_limits<Depth_Type>::max();
+
+    Depth_Container container;
+    std::size_t width;
+    std::size_t height;
+
+    /* Hierarchical level */
+    std::size_t columns;
+    std::size_t rows;
+    Depth_Container tile_min;
+    Depth_Container tile_max;
+    std::vector<std::uint8_t> tile_stale; /* tile_max is an upper bound until refreshed */
+
+    Depth_Buffer(std::size_t width, std::size_t height) :
+        container(Depth_Container(width * height, far)),
+        width(width),
+        height(height),
+        columns((width + tile_size - 1) / tile_size),
+        rows((height + tile_size - 1) / tile_size),
+        tile_min(Depth_Container(columns * rows, far)),
+        tile_max(Depth_Container(columns * rows, far)),
+        tile_stale(columns * rows, 0u)
+    {}
+
+    auto clear() -> void {
+        std::ranges::fill(container, far);
+        std::ranges::fill(tile_min, far);
+        std::ranges::fill(tile_max, far);
+        std::ranges::fill(tile_stale, 0u);
+    }
+
+    [[nodiscard]] auto at(std::size_t x, std::size_t y) const -> Depth_Type {
+        return container[y * width + x];
+    }
+
+    [[nodiscard]] auto tile_of(std::size_t x, std::size_t y) const -> std::size_t {
+        return (y / tile_size) * columns + x / tile_size;
+    }
+
+    /* No bounds check */
+    auto set(std::size_t x, std::size_t y, Depth_Type z) -> void {
+        container[y * width + x] = z;
+    }
+
+    /* Early depth test, no bounds check */
+    auto test_and_set(std::size_t x, std::size_t y, Depth_Type z) -> bool {
+        if (auto & stored = container[y * width + x]; z < stored) {
+            stored = z;
+            return true;
+        }
+        return false;
+    }
+
+    /* True when nothing at depth z or farther can pass in the tile */
+    auto occluded(std::size_t tile, Depth_Type z) -> bool {
+        if (z >= tile_max[tile]) {
+            return true;
+        }
+
+        if (tile_stale[tile]) {
+            refresh(tile);
+            return z >= tile_max[tile];
+        }
+
+        return false;
+    }
+
+    /* True when everything at depth z or closer passes in the tile */
+    [[nodiscard]] auto visible(std::size_t tile, Depth_Type z) const -> bool {
+        return z < tile_min[tile];
+    }
+
+    /* Record that the tile was written with depths no closer than z */
+    auto touch(std::size_t tile, Depth_Type z) -> void {
+        tile_min[tile] = std::min(tile_min[tile], z);
+        tile_stale[tile] = 1u;
+    }
+
+private:
+    auto refresh(std::size_t tile) -> void {
+        auto x0 = (tile % columns) * tile_size, y0 = (tile / columns) * tile_size;
+        auto x1 = std::min(x0 + tile_size, width), y1 = std::min(y0 + tile_size, height);
+
+        auto max = Depth_Type{ std::numeric_limits<Depth_Type>::lowest() };
+        for (auto y = y0; y < y1; ++y) {
+            auto row = std::next(std::cbegin(container), y * width);
+            max = std::max(max, *std::max_element(std::next(row, x0), std::next(row, x1)));
+        }
+
+        tile_max[tile] = max;
+        tile_stale[tile] = 0u;
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_DEPTH_BUFFER_HPP
@@ -1,32 +1,28 @@
 #ifndef CPP_ENGINE_DRAW_HPP
 #define CPP_ENGINE_DRAW_HPP
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include <fmt/core.h>
 
 #include "pixel-buffer.hpp"
 #include "geometry/2d/vector.hpp"
 
-namespace engine {
-
-/* ZINGL (2012) */
-template <class P = std::uint8_t, std::size_t C = 4, class T>
-auto discrete_line_plot(Buffer_2D<P, C> & buffer, T x0, T y0, T xn, T yn, std::array<P, C> const& color) -> void {
-    auto x1 = std::lround(x0), y1 = std::lround(y0);
-    auto x2 = std::lround(xn), y2 = std::lround(yn);
-
-    auto dx = std::abs(x2 - x1);
-    auto dy = -std::abs(y2 - y1);
-    auto error = dx + dy;
-
-    auto direction_x = x1 < x2 ? 1 : -1;
-    auto direction_y = y1 < y2 ? 1 : -1;
+namespace engine::details {
 
-    auto x = x1, y = y1;
+/* Lines reaching past this are dropped, it keeps the clipping products below 2^62 */
+inline constexpr auto max_line_coordinate = double(1l << 28);
 
-    while (x != x2 || y != y2) {
-        buffer.set(x, y, color);
+/* Takes count steps of a ZINGL walk from an arbitrary point of it, stops early if plot returns false */
+template <class Plot>
+auto zingl_steps(long x, long y, std::int64_t error, std::int64_t dx, std::int64_t dy,
+                 long direction_x, long direction_y, std::int64_t count, Plot && plot) -> void {
+    for (; count > 0; --count) {
+        if (plot(x, y) == false) {
+            return;
+        }
 
         auto double_error = error * 2;
 
@@ -42,6 +38,92 @@ auto discrete_line_plot(Buffer_2D<P, C> & buffer, T x0, T y0, T xn, T yn, std::a
     }
 }
 
+/* ZINGL (2012), visits every pixel from (x1, y1) up to, but not including, (x2, y2).
+ * Stops early if plot returns false. */
+template <class Plot>
+auto zingl_line_walk(long x1, long y1, long x2, long y2, Plot && plot) -> void {
+    auto dx = std::abs(std::int64_t(x2) - x1);
+    auto dy = -std::abs(std::int64_t(y2) - y1);
+
+    zingl_steps(x1, y1, dx + dy, dx, dy, x1 < x2 ? 1 : -1, y1 < y2 ? 1 : -1, std::max(dx, -dy), plot);
+}
+
+/**
+ * Same pixels as zingl_line_walk, restricted to clip without testing every pixel.
+ * The walk takes one pixel per step along the major axis, its k-th pixel lies
+ * floor((2 * k * minor + major) / (2 * major)) steps along the minor axis.
+ * The visible steps are solved from that in integers and the walk resumes at the first one.
+ * */
+template <class Plot>
+auto clipped_line_walk(long x1, long y1, long x2, long y2, Clip_Rect const& clip, Plot && plot) -> void {
+    auto a = std::abs(std::int64_t(x2) - x1);
+    auto b = std::abs(std::int64_t(y2) - y1);
+
+    auto direction_x = x1 < x2 ? 1l : -1l;
+    auto direction_y = y1 < y2 ? 1l : -1l;
+
+    /* clip window in steps taken along each axis */
+    auto low_x = direction_x > 0 ? std::int64_t(clip.x0) - x1 : std::int64_t(x1) - clip.x1;
+    auto high_x = direction_x > 0 ? std::int64_t(clip.x1) - x1 : std::int64_t(x1) - clip.x0;
+    auto low_y = direction_y > 0 ? std::int64_t(clip.y0) - y1 : std::int64_t(y1) - clip.y1;
+    auto high_y = direction_y > 0 ? std::int64_t(clip.y1) - y1 : std::int64_t(y1) - clip.y0;
+
+    auto x_major = a >= b;
+    auto major = x_major ? a : b, minor = x_major ? b : a;
+    auto low_minor = x_major ? low_y : low_x, high_minor = x_major ? high_y : high_x;
+
+    auto first = std::max(std::int64_t{0}, x_major ? low_x : low_y);
+    auto last = std::min(major - 1, x_major ? high_x : high_y);
+
+    auto floor_div = [](std::int64_t n, std::int64_t d) { return n / d - (n % d < 0 ? 1 : 0); };
+
+    if (minor == 0) {
+        if (low_minor > 0 || high_minor < 0) {
+            return;
+        }
+    } else {
+        first = std::max(first, -floor_div(major - 2 * major * low_minor, 2 * minor));
+        last = std::min(last, floor_div(2 * major * (high_minor + 1) - major - 1, 2 * minor));
+    }
+
+    if (first > last) {
+        return;
+    }
+
+    auto minor_steps = (2 * first * minor + major) / (2 * major);
+    auto steps_x = x_major ? first : minor_steps;
+    auto steps_y = x_major ? minor_steps : first;
+
+    zingl_steps(long(x1 + direction_x * steps_x), long(y1 + direction_y * steps_y), a - b - steps_x * b + steps_y * a,
+                a, -b, direction_x, direction_y, last - first + 1, plot);
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto discrete_line_plot(Buffer_2D<P, C> & buffer, T x0, T y0, T xn, T yn, std::array<P, C> const& color) -> void {
+    auto in_range = [](auto c) { return std::abs(double(c)) < details::max_line_coordinate; };
+
+    if (!in_range(x0) || !in_range(y0) || !in_range(xn) || !in_range(yn)) {
+        return;
+    }
+
+    auto x1 = std::lround(x0), y1 = std::lround(y0);
+    auto x2 = std::lround(xn), y2 = std::lround(yn);
+
+    buffer.mark_dirty({ std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2) });
+
+    /* clipped up front, every visited pixel is inside the buffer */
+    auto screen = Clip_Rect{ 0, 0, long(buffer.width) - 1, long(buffer.height) - 1 };
+
+    details::clipped_line_walk(x1, y1, x2, y2, screen, [&buffer, &color](auto x, auto y) {
+        buffer.set_unchecked(x, y, color);
+        return true;
+    });
+}
+
 template <class P = std::uint8_t, std::size_t C = 4, class T>
 auto discrete_line_plot(Buffer_2D<P, C> & buffer, Vector_2D<T> origin, Vector_2D<T> target,
                         std::array<P, C> const& color) -> void {
@@ -55,6 +137,9 @@ auto contiguous_line_plot(Buffer_2D<P, C> & buffer, T x0, T y0, T xn, T yn, std:
 
     auto size = std::abs(dx) + std::abs(dy);
 
+    buffer.mark_dirty({ long(std::floor(std::min(x0, xn))), long(std::floor(std::min(y0, yn))),
+                        long(std::ceil(std::max(x0, xn))), long(std::ceil(std::max(y0, yn))) });
+
     auto fx = dx / size;
     auto fy = dy / size;
 
@@ -85,6 +170,8 @@ auto bresenham(Buffer_2D<P, C> & buffer, Vector_2D<T> origin, Vector_2D<T> targe
     auto j = 2 * (dy - dx);
     auto d = i - dx;
 
+    buffer.mark_dirty({ x1, std::min(y1, y2), x2, std::max(y1, y2) });
+
     auto y = y1, x_max = x2;
 
     for (auto x = x1; x < x_max; ++x) {
@@ -103,27 +190,45 @@ auto bresenham(Buffer_2D<P, C> & buffer, Vector_2D<T> origin, Vector_2D<T> targe
 
 namespace engine::details {
 
-template <class P = std::uint8_t, std::size_t C = 4, class T>
-auto draw_solid_face(Buffer_2D<P, C> & buffer, Solid<T> const& solid, std::size_t face, std::array<P, C> const& color) -> void {
-    auto const& [ vertex, faces ] = solid;
+/* Calls edge(from, to) for every edge of a face, closing it back to the first vertex */
+template <class T, class Edge_Fn>
+auto for_each_face_edge(Solid<T> const& solid, std::size_t face, Edge_Fn && edge) -> void {
+    auto const& vertex = solid.vertex();
+    auto const& indexes = solid.faces()[face].indexes;
 
-    if (std::size(faces[face].indexes) > 2) {
-        for (auto i = 0ul; i < std::size(faces[face].indexes) - 1; ++i) {
+    if (std::size(indexes) > 2) {
+        for (auto i = 0ul; i < std::size(indexes) - 1; ++i) {
             /* draw line from current to next coordinate */
-            auto const& current = vertex[faces[face].indexes[i] - 1];
-            auto const& next = vertex[faces[face].indexes[i + 1] - 1];
-
-            discrete_line_plot(buffer, current.x, current.y, next.x, next.y, color);
+            edge(vertex[indexes[i] - 1], vertex[indexes[i + 1] - 1]);
         }
 
         /* draw line back */
-        auto const& first = vertex[faces[face].indexes.front() - 1];
-        auto const& last = vertex[faces[face].indexes.back() - 1];
+        edge(vertex[indexes.back() - 1], vertex[indexes.front() - 1]);
+    }
+}
 
-        discrete_line_plot(buffer, last.x, last.y, first.x, first.y, color);
+/* Calls edge(from, to) once per unique edge when the solid caches them, per face edge otherwise */
+template <class T, class Edge_Fn>
+auto for_each_solid_edge(Solid<T> const& solid, Edge_Fn && edge) -> void {
+    if (std::empty(solid.edges)) {
+        for (auto face = 0ul; face < std::size(solid.faces()); ++face) [[likely]] {
+            for_each_face_edge(solid, face, edge);
+        }
+        return;
+    }
+
+    for (auto const& [ from, to ] : solid.edges) [[likely]] {
+        edge(solid.vertex()[from], solid.vertex()[to]);
     }
 }
 
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_solid_face(Buffer_2D<P, C> & buffer, Solid<T> const& solid, std::size_t face, std::array<P, C> const& color) -> void {
+    for_each_face_edge(solid, face, [&buffer, &color](auto const& current, auto const& next) {
+        discrete_line_plot(buffer, current.x, current.y, next.x, next.y, color);
+    });
+}
+
 } // namespace engine::details
 
 namespace engine {
@@ -143,13 +248,32 @@ auto draw_triangle(Buffer_2D<P, C> & buffer, Triangle<T> triangle, std::array<P,
     discrete_line_plot(buffer, triangle.vertex[2], triangle.vertex[0], color);
 }
 
+/* Clip space line, clipped against the near plane and the guard band before the divide */
 template <class P = std::uint8_t, std::size_t C = 4, class T>
-auto draw_solid(Buffer_2D<P, C> & buffer, Solid<T> const& solid, std::array<P, C> const& color) -> void {
-    for (auto face = 0ul; face < std::size(solid.faces); ++face) [[likely]] {
-        details::draw_solid_face(buffer, solid, face, color);
+auto draw_line(Buffer_2D<P, C> & buffer, Vector_4D<T> const& from, Vector_4D<T> const& to, std::array<P, C> const& color,
+               Clip_Volume const& volume = {}) -> void {
+    if (auto line = clip_line(from, to, volume)) {
+        auto current = perspective_divide(line->from), next = perspective_divide(line->to);
+        discrete_line_plot(buffer, current.x, current.y, next.x, next.y, color);
     }
 }
 
+/* Clip space wireframe triangle, each edge is clipped on its own */
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_triangle(Buffer_2D<P, C> & buffer, std::array<Vector_4D<T>, 3> const& triangle, std::array<P, C> const& color,
+                   Clip_Volume const& volume = {}) -> void {
+    draw_line(buffer, triangle[0], triangle[1], color, volume);
+    draw_line(buffer, triangle[1], triangle[2], color, volume);
+    draw_line(buffer, triangle[2], triangle[0], color, volume);
+}
+
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_solid(Buffer_2D<P, C> & buffer, Solid<T> const& solid, std::array<P, C> const& color) -> void {
+    details::for_each_solid_edge(solid, [&buffer, &color](auto const& current, auto const& next) {
+        discrete_line_plot(buffer, current.x, current.y, next.x, next.y, color);
+    });
+}
+
 } // namespace engine
 
 #endif //CPP_ENGINE_DRAW_HPP
@@ -0,0 +1,139 @@
+#ifndef CPP_ENGINE_FRAME_PIPELINE_HPP
+#define CPP_ENGINE_FRAME_PIPELINE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pixel-buffer.hpp"
+#include "utility/bounded_queue.hpp"
+
+namespace engine {
+
+/**
+ * Rasterizes frames on a worker thread while the caller uploads and presents the previous one.
+ * Frames cycle between a free and a ready queue, jobs wait in a queue of one so input coalesces
+ * on the caller side instead of piling up behind the worker.
+ * */
+template <class Job>
+class Frame_Pipeline {
+public:
+    using Render = std::function<void(Job const&, Basic_RGBA_Buffer &)>;
+
+private:
+    std::vector<Basic_RGBA_Buffer> m_frames;
+    Render m_render;
+
+    util::Bounded_Queue<Job> m_jobs;
+    util::Bounded_Queue<std::size_t> m_free;
+    util::Bounded_Queue<std::size_t> m_ready;
+
+    std::mutex m_mutex;
+    std::condition_variable m_idle;
+    std::size_t m_in_flight;
+
+    std::thread m_worker;
+
+public:
+    /* Two frames double buffer, three let the worker run ahead of a slow present */
+    Frame_Pipeline(std::size_t width, std::size_t height, std::size_t frames, Render render) :
+        m_frames(std::max(frames, std::size_t{2}), Basic_RGBA_Buffer(width, height)),
+        m_render(std::move(render)),
+        m_jobs(1),
+        m_free(std::size(m_frames)),
+        m_ready(std::size(m_frames)),
+        m_mutex(),
+        m_idle(),
+        m_in_flight(0)
+    {
+        for (auto frame = 0ul; frame < std::size(m_frames); ++frame) {
+            m_free.push(frame);
+        }
+
+        m_worker = std::thread([this] { work(); });
+    }
+
+    Frame_Pipeline(Frame_Pipeline const&) = delete;
+    auto operator=(Frame_Pipeline const&) -> Frame_Pipeline & = delete;
+
+    ~Frame_Pipeline() {
+        m_jobs.close();
+        m_free.close();
+        m_worker.join();
+    }
+
+    /* Never blocks, false when the worker already has a job waiting */
+    auto submit(Job & job) -> bool {
+        {
+            auto lock = std::lock_guard{ m_mutex };
+            ++m_in_flight;
+        }
+
+        if (!m_jobs.try_push(job)) {
+            finish();
+            return false;
+        }
+
+        return true;
+    }
+
+    /* Hands the newest finished frame to present, older ones are dropped. False when none is ready */
+    template <class Present>
+    auto present(Present && present) -> bool {
+        auto newest = m_ready.try_pop();
+
+        if (!newest) {
+            return false;
+        }
+
+        while (auto next = m_ready.try_pop()) {
+            m_free.push(*newest);
+            newest = next;
+        }
+
+        present(m_frames[*newest]);
+        m_free.push(*newest);
+        return true;
+    }
+
+    /* Waits until the worker is done with every submitted job, finished frames are dropped */
+    auto wait_idle() -> void {
+        /* recycled first, the worker may need a free frame to get there */
+        while (auto frame = m_ready.try_pop()) {
+            m_free.push(*frame);
+        }
+
+        auto lock = std::unique_lock{ m_mutex };
+        m_idle.wait(lock, [this] { return m_in_flight == 0; });
+    }
+
+private:
+    auto work() -> void {
+        while (auto job = m_jobs.pop()) {
+            auto frame = m_free.pop();
+
+            if (!frame) {
+                return;
+            }
+
+            m_render(*job, m_frames[*frame]);
+            m_ready.push(*frame);
+            finish();
+        }
+    }
+
+    auto finish() -> void {
+        {
+            auto lock = std::lock_guard{ m_mutex };
+            --m_in_flight;
+        }
+        m_idle.notify_all();
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_FRAME_PIPELINE_HPP
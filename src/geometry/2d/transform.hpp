@@ -1,53 +1,137 @@
 #ifndef CPP_ENGINE_2D_TRANSFORM_HPP
 #define CPP_ENGINE_2D_TRANSFORM_HPP
 
+#include <cmath>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
 #include "vector.hpp"
+#include "../transform_base.hpp"
+#include "../trig.hpp"
 #include "../../utility/accessors.hpp"
 
 namespace engine::space2D {
 
 using engine::operator*; /* so ADL catches from Mat3 usage */
 
-struct Mat3 : Accessors_For<Mat3> {
-    using mat3_t = std::array<std::array<double, 3>, 3>;
+/* 3x3 homogeneous transform, same scalar and layout parameters as space3D::Basic_Mat4 */
+template <class S = double, Matrix_Layout Layout = Row_Major>
+struct Basic_Mat3 : Accessors_For<Basic_Mat3<S, Layout>> {
+    using scalar_type = S;
+    using layout_type = Layout;
+    using mat3_t = std::array<std::array<S, 3>, 3>;
+
+    alignas(details::matrix_alignment<S, 3>) mat3_t container;
+
+    [[nodiscard]] constexpr auto at(std::size_t row, std::size_t column) const -> S {
+        if constexpr (std::same_as<Layout, Row_Major>) {
+            return container[row][column];
+        } else {
+            return container[column][row];
+        }
+    }
 
-    mat3_t container;
+    static constexpr auto from_rows(details::Square<double, 3> const& rows) -> Basic_Mat3 {
+        auto out = Basic_Mat3{};
+        out.container = details::from_rows<S, 3, Layout>(rows);
+        return out;
+    }
 
-    static auto identity() -> Mat3 {
-        return /*Mat3*/ { .container = {{
+    static constexpr auto identity() -> Basic_Mat3 {
+        return from_rows({{
             { 1, 0, 0 },
             { 0, 1, 0 },
             { 0, 0, 1 }
-        }}};
+        }});
     }
 
-    static auto translate(double dx, double dy) -> Mat3 {
-        return /*Mat3*/ { .container = {{
+    static constexpr auto translate(double dx, double dy) -> Basic_Mat3 {
+        return from_rows({{
             { 1, 0, dx },
             { 0, 1, dy },
             { 0, 0, 1  }
-        }}};
+        }});
+    }
+
+    static auto rotate(double angle) -> Basic_Mat3 {
+        return rotate(sincos(angle));
+    }
+
+    /* Whole and half degrees come from a table */
+    static auto rotate(Degrees angle) -> Basic_Mat3 {
+        return rotate(sincos(angle));
     }
 
-    static auto rotate(double angle) -> Mat3 {
-        return /*Mat3*/ { .container = {{
-            { std::cos(angle),  std::sin(angle), 0 },
-            { -std::sin(angle), std::cos(angle), 0 },
-            { 0,                0,               1 }
-        }}};
+    static constexpr auto rotate(Sin_Cos<double> const& angle) -> Basic_Mat3 {
+        auto [ s, c ] = angle;
+
+        return from_rows({{
+            { c,  s, 0 },
+            { -s, c, 0 },
+            { 0,  0, 1 }
+        }});
     }
 };
 
-template <class T>
-auto apply_transform(Vector_2D<T> vec, Mat3 transform) -> Vector_2D<T> {
+using Mat3 = Basic_Mat3<double>;
+using Mat3f = Basic_Mat3<float>;
+
+template <class S, class L>
+constexpr auto operator*(Basic_Mat3<S, L> const& left, Basic_Mat3<S, L> const& right) -> Basic_Mat3<S, L> {
+    /* column-major storage holds the transpose, (AB)^T = B^T A^T */
+    auto const& first = std::same_as<L, Row_Major> ? left : right;
+    auto const& second = std::same_as<L, Row_Major> ? right : left;
+
+    auto product = Basic_Mat3<S, L>{};
+    product.container = details::multiply_storage(first.container, second.container);
+    return product;
+}
+
+template <class S, class L>
+auto transpose(Basic_Mat3<S, L> const& m) -> Basic_Mat3<S, L> {
+    auto out = Basic_Mat3<S, L>{};
+    out.container = details::transpose_storage(m.container);
+    return out;
+}
+
+/* Adjugate over the determinant, empty when singular. Works on the storage, inverse(M^T) = inverse(M)^T */
+template <class S, class L>
+auto inverse(Basic_Mat3<S, L> const& m) -> std::optional<Basic_Mat3<S, L>> {
+    auto const& a = m.container;
+
+    auto c00 = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+    auto c01 = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+    auto c02 = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+
+    auto det = a[0][0] * c00 + a[0][1] * c01 + a[0][2] * c02;
+
+    if (det == S(0)) {
+        return std::nullopt;
+    }
+
+    auto r = S(1) / det;
+    auto out = Basic_Mat3<S, L>{};
+
+    out.container = {{
+        { c00 * r, (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * r, (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * r },
+        { c01 * r, (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * r, (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * r },
+        { c02 * r, (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * r, (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * r }
+    }};
+
+    return out;
+}
+
+template <class T, class S, class L>
+auto apply_transform(Vector_2D<T> vec, Basic_Mat3<S, L> const& transform) -> Vector_2D<T> {
     return {
-        static_cast<T>(vec.x * transform[0][0] + vec.y * transform[0][1] + /*vec.w * */ transform[0][2]),
-        static_cast<T>(vec.x * transform[1][0] + vec.y * transform[1][1] + /*vec.w * */ transform[1][2])
+        static_cast<T>(vec.x * transform.at(0, 0) + vec.y * transform.at(0, 1) + /*vec.w * */ transform.at(0, 2)),
+        static_cast<T>(vec.x * transform.at(1, 0) + vec.y * transform.at(1, 1) + /*vec.w * */ transform.at(1, 2))
     };
 }
 
-template <class T>
-auto operator*(Vector_2D<T> vec, Mat3 transform) -> Vector_2D<T> {
+template <class T, class S, class L>
+auto operator*(Vector_2D<T> vec, Basic_Mat3<S, L> const& transform) -> Vector_2D<T> {
     return apply_transform(vec, transform);
 }
 
@@ -67,8 +151,10 @@ auto scale(Vector_2D<T> vec, Scalar a, Scalar b) -> Vector_2D<T> {
 
 template <class T, class Scalar>
 auto rotate(Vector_2D<T> vec, Scalar theta) -> Vector_2D<T> {
-    return { vec.x * std::cos(theta) + vec.y * std::sin(theta),
-             - vec.x * std::sin(theta) + vec.y * std::cos(theta) };
+    auto [ s, c ] = sincos(static_cast<std::conditional_t<std::floating_point<Scalar>, Scalar, double>>(theta));
+
+    return { vec.x * c + vec.y * s,
+             - vec.x * s + vec.y * c };
 }
 
 template <class T, class Scalar>
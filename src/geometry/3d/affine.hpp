@@ -0,0 +1,316 @@
+#ifndef CPP_ENGINE_AFFINE_HPP
+#define CPP_ENGINE_AFFINE_HPP
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+
+#include "../axis.hpp"
+#include "../transform_base.hpp"
+#include "../trig.hpp"
+#include "vector.hpp"
+#include "transform.hpp"
+
+/**
+ * Tagged transforms. Identity, Translation, Scaling and Rotation keep only their parameters, so the type of
+ * every factor in a chain is known at compile time. Products of the same kind fold into one factor, mixed
+ * products become an Affine (3x3 linear part plus offset) that only touches the rows or columns a factor moves.
+ * A full 4x4 product only happens once a Basic_Mat4 joins the chain, for example a perspective.
+ * */
+
+namespace engine::space3D {
+
+template <class Derived>
+struct Tagged_Transform;
+
+template <class T>
+concept Tagged = std::derived_from<T, Tagged_Transform<T>>;
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+/* Rows i and j of the rotation plane, the same sign convention as Basic_Mat4::rotate */
+template <axis::Axis A>
+inline constexpr auto rotation_plane = std::array<std::size_t, 2>{ 1, 2 };
+
+template <>
+inline constexpr auto rotation_plane<axis::Y_t> = std::array<std::size_t, 2>{ 0, 2 };
+
+template <>
+inline constexpr auto rotation_plane<axis::Z_t> = std::array<std::size_t, 2>{ 0, 1 };
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+template <class Derived>
+struct Tagged_Transform {
+    /* Converts when the chain ends up in a Mat4, transform_points deduces its matrix so it takes Mat4(chain) */
+    template <class S, class L>
+    constexpr operator Basic_Mat4<S, L>() const { // NOLINT(google-explicit-constructor)
+        auto const& [ linear, offset ] = static_cast<Derived const&>(*this).affine();
+
+        return Basic_Mat4<S, L>::from_rows({{
+            { linear[0][0], linear[0][1], linear[0][2], offset[0] },
+            { linear[1][0], linear[1][1], linear[1][2], offset[1] },
+            { linear[2][0], linear[2][1], linear[2][2], offset[2] },
+            { 0,            0,            0,            1         }
+        }});
+    }
+};
+
+/* p' = linear * p + offset, what mixed chains fold into */
+struct Affine : Tagged_Transform<Affine> {
+    details::Square<double, 3> linear = {};
+    std::array<double, 3> offset = {};
+
+    constexpr Affine() = default;
+
+    constexpr Affine(details::Square<double, 3> const& linear, std::array<double, 3> const& offset)
+            : linear{ linear }, offset{ offset } {}
+
+    [[nodiscard]] constexpr auto affine() const -> Affine const& {
+        return *this;
+    }
+};
+
+struct Identity : Tagged_Transform<Identity> {
+    [[nodiscard]] constexpr auto affine() const -> Affine {
+        return { {{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }}, { 0, 0, 0 } };
+    }
+};
+
+struct Translation : Tagged_Transform<Translation> {
+    double dx, dy, dz;
+
+    constexpr Translation(double dx, double dy, double dz) : dx{ dx }, dy{ dy }, dz{ dz } {}
+
+    [[nodiscard]] constexpr auto affine() const -> Affine {
+        return { {{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }}, { dx, dy, dz } };
+    }
+};
+
+struct Scaling : Tagged_Transform<Scaling> {
+    double sx, sy, sz;
+
+    constexpr Scaling(double sx, double sy, double sz) : sx{ sx }, sy{ sy }, sz{ sz } {}
+
+    [[nodiscard]] constexpr auto affine() const -> Affine {
+        return { {{ { sx, 0, 0 }, { 0, sy, 0 }, { 0, 0, sz } }}, { 0, 0, 0 } };
+    }
+};
+
+/* Cosine and sine are taken once, when the factor is made */
+template <axis::Axis A>
+struct Rotation : Tagged_Transform<Rotation<A>> {
+    double cos, sin;
+
+    Rotation(A, double angle) : Rotation{ sincos(angle) } {}
+
+    Rotation(A, Degrees angle) : Rotation{ sincos(angle) } {}
+
+    constexpr explicit Rotation(Sin_Cos<double> const& angle) : cos{ angle.cos }, sin{ angle.sin } {}
+
+    constexpr Rotation(double cos, double sin) : cos{ cos }, sin{ sin } {}
+
+    [[nodiscard]] constexpr auto affine() const -> Affine {
+        auto [ i, j ] = details::rotation_plane<A>;
+        auto out = Identity{}.affine();
+
+        out.linear[i][i] = cos;
+        out.linear[i][j] = sin;
+        out.linear[j][i] = -sin;
+        out.linear[j][j] = cos;
+
+        return out;
+    }
+};
+
+/**
+ * Folding rules, left * right applies right first as with Mat4.
+ * Same kind products stay one factor.
+ * */
+
+constexpr auto operator*(Identity, Identity) -> Identity {
+    return {};
+}
+
+template <Tagged R>
+constexpr auto operator*(Identity, R const& right) -> R {
+    return right;
+}
+
+template <Tagged L>
+constexpr auto operator*(L const& left, Identity) -> L {
+    return left;
+}
+
+constexpr auto operator*(Translation const& left, Translation const& right) -> Translation {
+    return { left.dx + right.dx, left.dy + right.dy, left.dz + right.dz };
+}
+
+constexpr auto operator*(Scaling const& left, Scaling const& right) -> Scaling {
+    return { left.sx * right.sx, left.sy * right.sy, left.sz * right.sz };
+}
+
+/* Angles about one axis add up */
+template <axis::Axis A>
+constexpr auto operator*(Rotation<A> const& left, Rotation<A> const& right) -> Rotation<A> {
+    return {
+        left.cos * right.cos - left.sin * right.sin,
+        left.sin * right.cos + left.cos * right.sin
+    };
+}
+
+/* General case, 27 multiplies for the linear part and 9 for the offset */
+constexpr auto operator*(Affine const& left, Affine const& right) -> Affine {
+    auto out = Affine{};
+
+    for (auto i = 0u; i < 3; ++i) {
+        for (auto j = 0u; j < 3; ++j) {
+            out.linear[i][j] = left.linear[i][0] * right.linear[0][j]
+                             + left.linear[i][1] * right.linear[1][j]
+                             + left.linear[i][2] * right.linear[2][j];
+        }
+
+        out.offset[i] = left.linear[i][0] * right.offset[0]
+                      + left.linear[i][1] * right.offset[1]
+                      + left.linear[i][2] * right.offset[2]
+                      + left.offset[i];
+    }
+
+    return out;
+}
+
+/* Moving after, only the offset changes */
+constexpr auto operator*(Translation const& left, Affine const& right) -> Affine {
+    auto out = right;
+
+    out.offset[0] += left.dx;
+    out.offset[1] += left.dy;
+    out.offset[2] += left.dz;
+
+    return out;
+}
+
+/* Moving before, the offset goes through the linear part */
+constexpr auto operator*(Affine const& left, Translation const& right) -> Affine {
+    auto out = left;
+
+    for (auto i = 0u; i < 3; ++i) {
+        out.offset[i] += left.linear[i][0] * right.dx + left.linear[i][1] * right.dy + left.linear[i][2] * right.dz;
+    }
+
+    return out;
+}
+
+/* Scaling after scales the rows */
+constexpr auto operator*(Scaling const& left, Affine const& right) -> Affine {
+    auto out = right;
+    auto factor = std::array{ left.sx, left.sy, left.sz };
+
+    for (auto i = 0u; i < 3; ++i) {
+        for (auto& x : out.linear[i]) {
+            x *= factor[i];
+        }
+        out.offset[i] *= factor[i];
+    }
+
+    return out;
+}
+
+/* Scaling before scales the columns */
+constexpr auto operator*(Affine const& left, Scaling const& right) -> Affine {
+    auto out = left;
+
+    for (auto& row : out.linear) {
+        row[0] *= right.sx;
+        row[1] *= right.sy;
+        row[2] *= right.sz;
+    }
+
+    return out;
+}
+
+/* Rotating after mixes two rows */
+template <axis::Axis A>
+constexpr auto operator*(Rotation<A> const& left, Affine const& right) -> Affine {
+    auto [ i, j ] = details::rotation_plane<A>;
+    auto out = right;
+
+    for (auto k = 0u; k < 3; ++k) {
+        out.linear[i][k] = left.cos * right.linear[i][k] + left.sin * right.linear[j][k];
+        out.linear[j][k] = left.cos * right.linear[j][k] - left.sin * right.linear[i][k];
+    }
+
+    out.offset[i] = left.cos * right.offset[i] + left.sin * right.offset[j];
+    out.offset[j] = left.cos * right.offset[j] - left.sin * right.offset[i];
+
+    return out;
+}
+
+/* Rotating before mixes two columns */
+template <axis::Axis A>
+constexpr auto operator*(Affine const& left, Rotation<A> const& right) -> Affine {
+    auto [ i, j ] = details::rotation_plane<A>;
+    auto out = left;
+
+    for (auto& row : out.linear) {
+        auto a = row[i], b = row[j];
+
+        row[i] = right.cos * a - right.sin * b;
+        row[j] = right.sin * a + right.cos * b;
+    }
+
+    return out;
+}
+
+constexpr auto operator*(Affine const& left, Identity) -> Affine {
+    return left;
+}
+
+/* Mixed kinds, the left factor becomes an Affine and one of the rules above takes the right one */
+template <Tagged L, Tagged R> requires (!std::same_as<L, Affine>)
+constexpr auto operator*(L const& left, R const& right) -> Affine {
+    return left.affine() * right;
+}
+
+/* No cheaper rule for the right factor, a plain affine product */
+template <Tagged R>
+constexpr auto operator*(Affine const& left, R const& right) -> Affine {
+    return left * Affine{ right.affine() };
+}
+
+/* A full matrix in the chain, one 4x4 product from here on */
+template <Tagged L, class S, class Layout>
+auto operator*(L const& left, Basic_Mat4<S, Layout> const& right) -> Basic_Mat4<S, Layout> {
+    return Basic_Mat4<S, Layout>(left) * right;
+}
+
+template <class S, class Layout, Tagged R>
+auto operator*(Basic_Mat4<S, Layout> const& left, R const& right) -> Basic_Mat4<S, Layout> {
+    return left * Basic_Mat4<S, Layout>(right);
+}
+
+/* 9 multiplies and 9 adds per point */
+template <class T, Tagged M>
+auto apply_transform(Vector_3D<T> const& vec, M const& transform) -> Vector_3D<T> {
+    auto const& [ linear, offset ] = transform.affine();
+
+    return {
+        T(vec.x * linear[0][0] + vec.y * linear[0][1] + vec.z * linear[0][2] + offset[0]),
+        T(vec.x * linear[1][0] + vec.y * linear[1][1] + vec.z * linear[1][2] + offset[1]),
+        T(vec.x * linear[2][0] + vec.y * linear[2][1] + vec.z * linear[2][2] + offset[2])
+    };
+}
+
+template <class T, Tagged M>
+auto operator*(Vector_3D<T> const& vec, M const& transform) -> Vector_3D<T> {
+    return apply_transform(vec, transform);
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_AFFINE_HPP
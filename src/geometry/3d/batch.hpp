@@ -0,0 +1,440 @@
+#ifndef CPP_ENGINE_BATCH_HPP
+#define CPP_ENGINE_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vector.hpp"
+#include "transform.hpp"
+#include "../../utility/cpu.hpp"
+
+namespace engine::space3D {
+
+/* Bottom row (0, 0, 0, 1), w is always 1 and the divide can be skipped */
+template <class S, class L>
+auto is_affine(Basic_Mat4<S, L> const& transform) -> bool {
+    return transform.at(3, 0) == 0 && transform.at(3, 1) == 0 && transform.at(3, 2) == 0 && transform.at(3, 3) == 1;
+}
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+/* Vertices per parallel task */
+inline constexpr auto transform_chunk = 4096ul;
+
+/* The vector kernels load vertices as packed triples */
+template <class T>
+inline constexpr auto packed_vertex = sizeof(space3D::Vector_3D<T>) == 3 * sizeof(T)
+                                      && (std::is_same_v<T, double> || std::is_same_v<T, float>);
+
+/* Same arithmetic as apply_transform, w is skipped when Projective is false */
+template <bool Projective, class T, class S, class L>
+auto transform_points_scalar(space3D::Vector_3D<T> const* in, space3D::Basic_Mat4<S, L> const& m,
+                             space3D::Vector_3D<T> * out, std::size_t count) -> void {
+    for (auto i = 0ul; i < count; ++i) {
+        if constexpr (Projective) {
+            out[i] = space3D::apply_transform(in[i], m);
+        } else {
+            auto const& v = in[i];
+            out[i] = {
+                T(v.x * m.at(0, 0) + v.y * m.at(0, 1) + v.z * m.at(0, 2) + m.at(0, 3)),
+                T(v.x * m.at(1, 0) + v.y * m.at(1, 1) + v.z * m.at(1, 2) + m.at(1, 3)),
+                T(v.x * m.at(2, 0) + v.y * m.at(2, 1) + v.z * m.at(2, 2) + m.at(2, 3))
+            };
+        }
+    }
+}
+
+#if defined(CPP_ENGINE_X86)
+
+/* [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] to x, y, z lanes and back */
+CPP_ENGINE_TARGET_AVX2
+inline auto soa_x4(__m256d a, __m256d b, __m256d c, __m256d & x, __m256d & y, __m256d & z) -> void {
+    auto t1 = _mm256_permute2f128_pd(a, b, 0x30); /* x0 y0 x2 y2 */
+    auto t2 = _mm256_permute2f128_pd(a, c, 0x21); /* z0 x1 z2 x3 */
+    auto t3 = _mm256_permute2f128_pd(b, c, 0x30); /* y1 z1 y3 z3 */
+
+    x = _mm256_shuffle_pd(t1, t2, 0b1010);
+    y = _mm256_shuffle_pd(t1, t3, 0b0101);
+    z = _mm256_shuffle_pd(t2, t3, 0b1010);
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto aos_x4(__m256d x, __m256d y, __m256d z, __m256d & a, __m256d & b, __m256d & c) -> void {
+    auto t1 = _mm256_shuffle_pd(x, y, 0b0000); /* x0 y0 x2 y2 */
+    auto t2 = _mm256_shuffle_pd(z, x, 0b1010); /* z0 x1 z2 x3 */
+    auto t3 = _mm256_shuffle_pd(y, z, 0b1111); /* y1 z1 y3 z3 */
+
+    a = _mm256_permute2f128_pd(t1, t2, 0x20);
+    b = _mm256_permute2f128_pd(t3, t1, 0x30);
+    c = _mm256_permute2f128_pd(t2, t3, 0x31);
+}
+
+/* One matrix row over four vertices, summed in the scalar order so results match apply_transform */
+template <class L>
+CPP_ENGINE_TARGET_AVX2
+inline auto row_x4(space3D::Basic_Mat4<double, L> const& m, std::size_t row, __m256d x, __m256d y, __m256d z) -> __m256d {
+    auto sum = _mm256_mul_pd(x, _mm256_set1_pd(m.at(row, 0)));
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(y, _mm256_set1_pd(m.at(row, 1))));
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(z, _mm256_set1_pd(m.at(row, 2))));
+    return _mm256_add_pd(sum, _mm256_set1_pd(m.at(row, 3)));
+}
+
+/* Four vertices per instruction in double, floats are widened exactly and narrowed like the scalar casts */
+template <bool Projective, class T, class L>
+CPP_ENGINE_TARGET_AVX2
+auto transform_points_avx2(space3D::Vector_3D<T> const* in, space3D::Basic_Mat4<double, L> const& m,
+                           space3D::Vector_3D<T> * out, std::size_t count) -> std::size_t {
+    auto done = count - count % 4;
+
+    for (auto i = 0ul; i < done; i += 4) {
+        auto source = reinterpret_cast<T const*>(in + i);
+        auto target = reinterpret_cast<T *>(out + i);
+
+        auto a = __m256d{}, b = __m256d{}, c = __m256d{};
+
+        if constexpr (std::is_same_v<T, double>) {
+            a = _mm256_loadu_pd(source);
+            b = _mm256_loadu_pd(source + 4);
+            c = _mm256_loadu_pd(source + 8);
+        } else {
+            a = _mm256_cvtps_pd(_mm_loadu_ps(source));
+            b = _mm256_cvtps_pd(_mm_loadu_ps(source + 4));
+            c = _mm256_cvtps_pd(_mm_loadu_ps(source + 8));
+        }
+
+        auto x = __m256d{}, y = __m256d{}, z = __m256d{};
+        soa_x4(a, b, c, x, y, z);
+
+        auto tx = row_x4(m, 0, x, y, z);
+        auto ty = row_x4(m, 1, x, y, z);
+        auto tz = row_x4(m, 2, x, y, z);
+
+        if constexpr (std::is_same_v<T, float>) {
+            /* round to float first, the scalar path divides in T */
+            tx = _mm256_cvtps_pd(_mm256_cvtpd_ps(tx));
+            ty = _mm256_cvtps_pd(_mm256_cvtpd_ps(ty));
+            tz = _mm256_cvtps_pd(_mm256_cvtpd_ps(tz));
+        }
+
+        if constexpr (Projective) {
+            auto w = row_x4(m, 3, x, y, z);
+
+            if constexpr (std::is_same_v<T, float>) {
+                w = _mm256_cvtps_pd(_mm256_cvtpd_ps(w));
+            }
+
+            /* w == 0 leaves the lane undivided */
+            auto zero = _mm256_cmp_pd(w, _mm256_setzero_pd(), _CMP_EQ_OQ);
+            auto divisor = _mm256_blendv_pd(w, _mm256_set1_pd(1.0), zero);
+
+            if constexpr (std::is_same_v<T, double>) {
+                tx = _mm256_div_pd(tx, divisor);
+                ty = _mm256_div_pd(ty, divisor);
+                tz = _mm256_div_pd(tz, divisor);
+            } else {
+                auto divisor_f = _mm256_cvtpd_ps(divisor);
+                tx = _mm256_cvtps_pd(_mm_div_ps(_mm256_cvtpd_ps(tx), divisor_f));
+                ty = _mm256_cvtps_pd(_mm_div_ps(_mm256_cvtpd_ps(ty), divisor_f));
+                tz = _mm256_cvtps_pd(_mm_div_ps(_mm256_cvtpd_ps(tz), divisor_f));
+            }
+        }
+
+        aos_x4(tx, ty, tz, a, b, c);
+
+        if constexpr (std::is_same_v<T, double>) {
+            _mm256_storeu_pd(target, a);
+            _mm256_storeu_pd(target + 4, b);
+            _mm256_storeu_pd(target + 8, c);
+        } else {
+            _mm_storeu_ps(target, _mm256_cvtpd_ps(a));
+            _mm_storeu_ps(target + 4, _mm256_cvtpd_ps(b));
+            _mm_storeu_ps(target + 8, _mm256_cvtpd_ps(c));
+        }
+    }
+
+    return done;
+}
+
+template <class L>
+CPP_ENGINE_TARGET_SSE2
+inline auto row_x2(space3D::Basic_Mat4<double, L> const& m, std::size_t row, __m128d x, __m128d y, __m128d z) -> __m128d {
+    auto sum = _mm_mul_pd(x, _mm_set1_pd(m.at(row, 0)));
+    sum = _mm_add_pd(sum, _mm_mul_pd(y, _mm_set1_pd(m.at(row, 1))));
+    sum = _mm_add_pd(sum, _mm_mul_pd(z, _mm_set1_pd(m.at(row, 2))));
+    return _mm_add_pd(sum, _mm_set1_pd(m.at(row, 3)));
+}
+
+/* Two double vertices per instruction, [x0 y0] [z0 x1] [y1 z1] */
+template <bool Projective, class L>
+CPP_ENGINE_TARGET_SSE2
+auto transform_points_sse2(space3D::Vector_3D<double> const* in, space3D::Basic_Mat4<double, L> const& m,
+                           space3D::Vector_3D<double> * out, std::size_t count) -> std::size_t {
+    auto done = count - count % 2;
+
+    for (auto i = 0ul; i < done; i += 2) {
+        auto source = reinterpret_cast<double const*>(in + i);
+        auto target = reinterpret_cast<double *>(out + i);
+
+        auto v0 = _mm_loadu_pd(source), v1 = _mm_loadu_pd(source + 2), v2 = _mm_loadu_pd(source + 4);
+
+        auto x = _mm_shuffle_pd(v0, v1, 0b10);
+        auto y = _mm_shuffle_pd(v0, v2, 0b01);
+        auto z = _mm_shuffle_pd(v1, v2, 0b10);
+
+        auto tx = row_x2(m, 0, x, y, z);
+        auto ty = row_x2(m, 1, x, y, z);
+        auto tz = row_x2(m, 2, x, y, z);
+
+        if constexpr (Projective) {
+            auto w = row_x2(m, 3, x, y, z);
+            auto zero = _mm_cmpeq_pd(w, _mm_setzero_pd());
+            auto divisor = _mm_or_pd(_mm_and_pd(zero, _mm_set1_pd(1.0)), _mm_andnot_pd(zero, w));
+
+            tx = _mm_div_pd(tx, divisor);
+            ty = _mm_div_pd(ty, divisor);
+            tz = _mm_div_pd(tz, divisor);
+        }
+
+        _mm_storeu_pd(target, _mm_shuffle_pd(tx, ty, 0b00));
+        _mm_storeu_pd(target + 2, _mm_shuffle_pd(tz, tx, 0b10));
+        _mm_storeu_pd(target + 4, _mm_shuffle_pd(ty, tz, 0b11));
+    }
+
+    return done;
+}
+
+
+/**
+ * Float matrices on float vertices stay in float, like apply_transform does for them. Three registers hold four
+ * packed vertices per 128 bit lane, [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3], the shuffles work within a lane.
+ * */
+CPP_ENGINE_TARGET_SSE2
+inline auto soa_x4(__m128 a, __m128 b, __m128 c, __m128 & x, __m128 & y, __m128 & z) -> void {
+    auto xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); /* x2 y2 x3 y3 */
+    auto yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1)); /* y0 z0 y1 z1 */
+
+    x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+CPP_ENGINE_TARGET_SSE2
+inline auto aos_x4(__m128 x, __m128 y, __m128 z, __m128 & a, __m128 & b, __m128 & c) -> void {
+    auto xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0)); /* x0 x2 y0 y2 */
+    auto yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1)); /* y1 y3 z1 z3 */
+    auto zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0)); /* z0 z2 x1 x3 */
+
+    a = _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    c = _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+/* The same shuffles on both lanes, vertices 0 to 3 low and 4 to 7 high */
+CPP_ENGINE_TARGET_AVX2
+inline auto soa_x8(__m256 a, __m256 b, __m256 c, __m256 & x, __m256 & y, __m256 & z) -> void {
+    auto xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    auto yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+    x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto aos_x8(__m256 x, __m256 y, __m256 z, __m256 & a, __m256 & b, __m256 & c) -> void {
+    auto xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    auto yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    auto zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+
+    a = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    c = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+template <class L>
+CPP_ENGINE_TARGET_SSE2
+inline auto row_x4(space3D::Basic_Mat4<float, L> const& m, std::size_t row, __m128 x, __m128 y, __m128 z) -> __m128 {
+    auto sum = _mm_mul_ps(x, _mm_set1_ps(m.at(row, 0)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(y, _mm_set1_ps(m.at(row, 1))));
+    sum = _mm_add_ps(sum, _mm_mul_ps(z, _mm_set1_ps(m.at(row, 2))));
+    return _mm_add_ps(sum, _mm_set1_ps(m.at(row, 3)));
+}
+
+template <class L>
+CPP_ENGINE_TARGET_AVX2
+inline auto row_x8(space3D::Basic_Mat4<float, L> const& m, std::size_t row, __m256 x, __m256 y, __m256 z) -> __m256 {
+    auto sum = _mm256_mul_ps(x, _mm256_set1_ps(m.at(row, 0)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(y, _mm256_set1_ps(m.at(row, 1))));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(z, _mm256_set1_ps(m.at(row, 2))));
+    return _mm256_add_ps(sum, _mm256_set1_ps(m.at(row, 3)));
+}
+
+/* Eight float vertices per instruction */
+template <bool Projective, class L>
+CPP_ENGINE_TARGET_AVX2
+auto transform_points_avx2(space3D::Vector_3D<float> const* in, space3D::Basic_Mat4<float, L> const& m,
+                           space3D::Vector_3D<float> * out, std::size_t count) -> std::size_t {
+    auto done = count - count % 8;
+
+    for (auto i = 0ul; i < done; i += 8) {
+        auto source = reinterpret_cast<float const*>(in + i);
+        auto target = reinterpret_cast<float *>(out + i);
+
+        auto a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source)), _mm_loadu_ps(source + 12), 1);
+        auto b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source + 4)), _mm_loadu_ps(source + 16), 1);
+        auto c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source + 8)), _mm_loadu_ps(source + 20), 1);
+
+        auto x = __m256{}, y = __m256{}, z = __m256{};
+        soa_x8(a, b, c, x, y, z);
+
+        auto tx = row_x8(m, 0, x, y, z);
+        auto ty = row_x8(m, 1, x, y, z);
+        auto tz = row_x8(m, 2, x, y, z);
+
+        if constexpr (Projective) {
+            auto w = row_x8(m, 3, x, y, z);
+
+            /* w == 0 leaves the lane undivided */
+            auto divisor = _mm256_blendv_ps(w, _mm256_set1_ps(1.0f), _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ));
+
+            tx = _mm256_div_ps(tx, divisor);
+            ty = _mm256_div_ps(ty, divisor);
+            tz = _mm256_div_ps(tz, divisor);
+        }
+
+        aos_x8(tx, ty, tz, a, b, c);
+
+        _mm_storeu_ps(target, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(target + 4, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(target + 8, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(target + 12, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(target + 16, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(target + 20, _mm256_extractf128_ps(c, 1));
+    }
+
+    return done;
+}
+
+/* Four float vertices per instruction */
+template <bool Projective, class L>
+CPP_ENGINE_TARGET_SSE2
+auto transform_points_sse2(space3D::Vector_3D<float> const* in, space3D::Basic_Mat4<float, L> const& m,
+                           space3D::Vector_3D<float> * out, std::size_t count) -> std::size_t {
+    auto done = count - count % 4;
+
+    for (auto i = 0ul; i < done; i += 4) {
+        auto source = reinterpret_cast<float const*>(in + i);
+        auto target = reinterpret_cast<float *>(out + i);
+
+        auto a = _mm_loadu_ps(source), b = _mm_loadu_ps(source + 4), c = _mm_loadu_ps(source + 8);
+
+        auto x = __m128{}, y = __m128{}, z = __m128{};
+        soa_x4(a, b, c, x, y, z);
+
+        auto tx = row_x4(m, 0, x, y, z);
+        auto ty = row_x4(m, 1, x, y, z);
+        auto tz = row_x4(m, 2, x, y, z);
+
+        if constexpr (Projective) {
+            auto w = row_x4(m, 3, x, y, z);
+            auto zero = _mm_cmpeq_ps(w, _mm_setzero_ps());
+            auto divisor = _mm_or_ps(_mm_and_ps(zero, _mm_set1_ps(1.0f)), _mm_andnot_ps(zero, w));
+
+            tx = _mm_div_ps(tx, divisor);
+            ty = _mm_div_ps(ty, divisor);
+            tz = _mm_div_ps(tz, divisor);
+        }
+
+        aos_x4(tx, ty, tz, a, b, c);
+
+        _mm_storeu_ps(target, a);
+        _mm_storeu_ps(target + 4, b);
+        _mm_storeu_ps(target + 8, c);
+    }
+
+    return done;
+}
+
+#endif
+
+template <bool Projective, class T, class S, class L>
+auto transform_points(space3D::Vector_3D<T> const* in, space3D::Basic_Mat4<S, L> const& m, space3D::Vector_3D<T> * out,
+                      std::size_t count) -> void {
+    auto done = 0ul;
+
+#if defined(CPP_ENGINE_X86)
+    if constexpr (packed_vertex<T> && std::is_same_v<S, double>) {
+        if (cpu::features().avx2) {
+            done = transform_points_avx2<Projective>(in, m, out, count);
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (cpu::features().sse2) {
+                done = transform_points_sse2<Projective>(in, m, out, count);
+            }
+        }
+    } else if constexpr (packed_vertex<T> && std::is_same_v<S, float> && std::is_same_v<T, float>) {
+        if (cpu::features().avx2) {
+            done = transform_points_avx2<Projective>(in, m, out, count);
+        } else if (cpu::features().sse2) {
+            done = transform_points_sse2<Projective>(in, m, out, count);
+        }
+    }
+#endif
+
+    transform_points_scalar<Projective>(in + done, m, out + done, count - done);
+}
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+/**
+ * in * transform for every point, out must be at least as long as in and may alias it. Any scalar and layout,
+ * double matrices run four vertices per instruction, float matrices on float vertices eight with AVX2.
+ * */
+template <class T, class S, class L>
+auto transform_points_affine(std::span<Vector_3D<T> const> in, Basic_Mat4<S, L> const& transform,
+                             std::span<Vector_3D<T>> out) -> void {
+    details::transform_points<false>(std::data(in), transform, std::data(out), std::size(in));
+}
+
+template <class T, class S, class L>
+auto transform_points_projective(std::span<Vector_3D<T> const> in, Basic_Mat4<S, L> const& transform,
+                                 std::span<Vector_3D<T>> out) -> void {
+    details::transform_points<true>(std::data(in), transform, std::data(out), std::size(in));
+}
+
+/* Equal to apply_transform per point, the divide is only done when the bottom row asks for it */
+template <class T, class S, class L>
+auto transform_points(std::span<Vector_3D<T> const> in, Basic_Mat4<S, L> const& transform, std::span<Vector_3D<T>> out) -> void {
+    if (is_affine(transform)) {
+        transform_points_affine(in, transform, out);
+    } else {
+        transform_points_projective(in, transform, out);
+    }
+}
+
+/* Chunks of the batch run under policy, T first so containers convert: transform_points<T>(par, vertex, m, view) */
+template <class T, class Policy, class S, class L>
+auto transform_points(Policy && policy, std::span<Vector_3D<T> const> in, Basic_Mat4<S, L> const& transform,
+                      std::span<Vector_3D<T>> out) -> void {
+    auto chunks = std::vector<std::size_t>((std::size(in) + details::transform_chunk - 1) / details::transform_chunk);
+    std::generate(std::begin(chunks), std::end(chunks), [first = 0ul]() mutable {
+        return std::exchange(first, first + details::transform_chunk);
+    });
+
+    std::for_each(policy, std::cbegin(chunks), std::cend(chunks), [&in, &transform, &out](std::size_t first) {
+        auto count = std::min(details::transform_chunk, std::size(in) - first);
+        transform_points(in.subspan(first, count), transform, out.subspan(first, count));
+    });
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_BATCH_HPP
@@ -0,0 +1,193 @@
+#ifndef CPP_ENGINE_BOUNDS_HPP
+#define CPP_ENGINE_BOUNDS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+
+#include "vector.hpp"
+#include "batch.hpp"
+#include "../../utility/cpu.hpp"
+
+namespace engine::space3D {
+
+/* Axis aligned box, min and max hold the smallest and largest value on each axis */
+template <class T>
+struct Aabb {
+    Vector_3D<T> min;
+    Vector_3D<T> max;
+
+    [[nodiscard]] constexpr auto center() const -> Vector_3D<T> {
+        return { std::midpoint(min.x, max.x), std::midpoint(min.y, max.y), std::midpoint(min.z, max.z) };
+    }
+
+    [[nodiscard]] constexpr auto contains(Vector_3D<T> const& p) const -> bool {
+        return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y && min.z <= p.z && p.z <= max.z;
+    }
+};
+
+template <class T>
+struct Bounding_Sphere {
+    Vector_3D<T> center;
+    T radius;
+};
+
+/**
+ * Both volumes of a vertex set. The sphere surrounds the box, centred on it with half the diagonal as radius,
+ * so it comes out of the same pass. It can be up to sqrt(3) wider than the tightest sphere, fine for rejecting.
+ * */
+template <class T>
+struct Bounds {
+    Aabb<T> box;
+    Bounding_Sphere<T> sphere;
+};
+
+template <class T>
+constexpr auto overlap(Aabb<T> const& a, Aabb<T> const& b) -> bool {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x
+        && a.min.y <= b.max.y && b.min.y <= a.max.y
+        && a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
+
+template <class T>
+auto overlap(Bounding_Sphere<T> const& a, Bounding_Sphere<T> const& b) -> bool {
+    auto reach = a.radius + b.radius;
+    return distance_squared(a.center, b.center) <= reach * reach;
+}
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+template <class T>
+auto bounds_scalar(space3D::Vector_3D<T> const* in, std::size_t count, space3D::Aabb<T> & box) -> void {
+    for (auto i = 0ul; i < count; ++i) {
+        auto const& v = in[i];
+
+        box.min = { std::min(box.min.x, v.x), std::min(box.min.y, v.y), std::min(box.min.z, v.z) };
+        box.max = { std::max(box.max.x, v.x), std::max(box.max.y, v.y), std::max(box.max.z, v.z) };
+    }
+}
+
+#if defined(CPP_ENGINE_X86)
+
+/* Four vertices per step, split into x, y, z lanes the same way the transform kernel does */
+CPP_ENGINE_TARGET_AVX2
+inline auto bounds_avx2(space3D::Vector_3D<double> const* in, std::size_t count, space3D::Aabb<double> & box) -> std::size_t {
+    auto done = count & ~3ul;
+
+    if (done == 0) {
+        return 0;
+    }
+
+    auto const* p = &in[0].x;
+    auto lo_x = _mm256_set1_pd(box.min.x), lo_y = _mm256_set1_pd(box.min.y), lo_z = _mm256_set1_pd(box.min.z);
+    auto hi_x = _mm256_set1_pd(box.max.x), hi_y = _mm256_set1_pd(box.max.y), hi_z = _mm256_set1_pd(box.max.z);
+
+    for (auto i = 0ul; i < done; i += 4, p += 12) {
+        auto x = __m256d{}, y = __m256d{}, z = __m256d{};
+        soa_x4(_mm256_loadu_pd(p), _mm256_loadu_pd(p + 4), _mm256_loadu_pd(p + 8), x, y, z);
+
+        lo_x = _mm256_min_pd(lo_x, x); hi_x = _mm256_max_pd(hi_x, x);
+        lo_y = _mm256_min_pd(lo_y, y); hi_y = _mm256_max_pd(hi_y, y);
+        lo_z = _mm256_min_pd(lo_z, z); hi_z = _mm256_max_pd(hi_z, z);
+    }
+
+    auto reduce = [](__m256d v, auto pick) CPP_ENGINE_TARGET_AVX2 {
+        auto half = pick(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(pick(half, _mm_unpackhi_pd(half, half)));
+    };
+    auto min = [](__m128d a, __m128d b) CPP_ENGINE_TARGET_AVX2 { return _mm_min_pd(a, b); };
+    auto max = [](__m128d a, __m128d b) CPP_ENGINE_TARGET_AVX2 { return _mm_max_pd(a, b); };
+
+    box.min = { reduce(lo_x, min), reduce(lo_y, min), reduce(lo_z, min) };
+    box.max = { reduce(hi_x, max), reduce(hi_y, max), reduce(hi_z, max) };
+
+    return done;
+}
+
+/* One vertex per step with x, y, z side by side, the last one is left to the scalar loop so no load runs past the end */
+CPP_ENGINE_TARGET_SSE2
+inline auto bounds_sse2(space3D::Vector_3D<float> const* in, std::size_t count, space3D::Aabb<float> & box) -> std::size_t {
+    if (count < 2) {
+        return 0;
+    }
+
+    auto lo = _mm_setr_ps(box.min.x, box.min.y, box.min.z, 0.0f);
+    auto hi = _mm_setr_ps(box.max.x, box.max.y, box.max.z, 0.0f);
+
+    for (auto i = 0ul; i + 1 < count; ++i) {
+        auto v = _mm_loadu_ps(&in[i].x);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+    }
+
+    alignas(16) float out[2][4];
+    _mm_store_ps(out[0], lo);
+    _mm_store_ps(out[1], hi);
+
+    box.min = { out[0][0], out[0][1], out[0][2] };
+    box.max = { out[1][0], out[1][1], out[1][2] };
+
+    return count - 1;
+}
+
+#endif
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+/* One pass over vertex, an empty set gives a zero box at the origin */
+template <class T>
+auto compute_bounds(std::span<Vector_3D<T> const> vertex) -> Bounds<T> {
+    if (std::empty(vertex)) {
+        return {};
+    }
+
+    auto box = Aabb<T>{ vertex[0], vertex[0] };
+    auto done = 0ul;
+
+#if defined(CPP_ENGINE_X86)
+    if constexpr (details::packed_vertex<T> && std::is_same_v<T, double>) {
+        if (cpu::features().avx2) {
+            done = details::bounds_avx2(std::data(vertex), std::size(vertex), box);
+        }
+    } else if constexpr (details::packed_vertex<T> && std::is_same_v<T, float>) {
+        if (cpu::features().sse2) {
+            done = details::bounds_sse2(std::data(vertex), std::size(vertex), box);
+        }
+    }
+#endif
+
+    details::bounds_scalar(std::data(vertex) + done, std::size(vertex) - done, box);
+
+    /**
+     * Reach of the farthest box corner from the centre as stored, rounded or not. A test d^2 > r^2 done in T
+     * rounds the differences and squares by a few ulp of r, so the radius is padded by that much and rounded up.
+     * Integer T rounds the radius up to the next whole value.
+     * */
+    auto center = box.center();
+    auto reach_axis = [](T low, T high, T middle) {
+        return std::max(double(high) - double(middle), double(middle) - double(low));
+    };
+    auto reach = Vector_3D<double>{
+        reach_axis(box.min.x, box.max.x, center.x), reach_axis(box.min.y, box.max.y, center.y), reach_axis(box.min.z, box.max.z, center.z)
+    };
+    auto distance = std::sqrt(dot_product(reach, reach));
+
+    if constexpr (std::is_floating_point_v<T>) {
+        auto padded = T(distance * (1 + 8 * double(std::numeric_limits<T>::epsilon())));
+        return { box, { center, std::nextafter(padded, std::numeric_limits<T>::infinity()) } };
+    } else {
+        return { box, { center, T(std::ceil(distance)) } };
+    }
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_BOUNDS_HPP
@@ -0,0 +1,173 @@
+#ifndef CPP_ENGINE_CLIP_HPP
+#define CPP_ENGINE_CLIP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "vector.hpp"
+
+namespace engine::space3D {
+
+/**
+ * Near plane in w and guard band in screen units, after the divide.
+ * Primitives inside the band go to the rasterizer unclipped, it already clips to the target for free.
+ * The band keeps coordinates well inside what the line walk and the triangle setup take exactly.
+ * */
+struct Clip_Volume {
+    static constexpr double guard_band = double(1 << 22);
+
+    double near_w = 0.1;
+    double min_x = -guard_band, min_y = -guard_band;
+    double max_x = guard_band, max_y = guard_band;
+};
+
+/* Room for one extra vertex per plane */
+template <class T>
+struct Clipped_Polygon {
+    std::array<Vector_4D<T>, 8> vertex;
+    std::size_t count;
+};
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+inline constexpr auto clip_planes = 5u;
+
+/* Signed distance to plane, inside is positive. Plane 0 is near, then the band left, right, top and bottom */
+template <class T>
+auto plane_distance(space3D::Vector_4D<T> const& v, unsigned plane, space3D::Clip_Volume const& volume) -> double {
+    auto x = double(v.x), y = double(v.y), w = double(v.w);
+
+    switch (plane) {
+        case 0:  return w - volume.near_w;
+        case 1:  return x - volume.min_x * w;
+        case 2:  return volume.max_x * w - x;
+        case 3:  return y - volume.min_y * w;
+        default: return volume.max_y * w - y;
+    }
+}
+
+/* One bit per plane the point is outside of */
+template <class T>
+auto outcode(space3D::Vector_4D<T> const& v, space3D::Clip_Volume const& volume) -> unsigned {
+    auto code = 0u;
+
+    for (auto plane = 0u; plane < clip_planes; ++plane) {
+        if (plane_distance(v, plane, volume) < 0) {
+            code |= 1u << plane;
+        }
+    }
+
+    return code;
+}
+
+template <class T>
+auto clip_lerp(space3D::Vector_4D<T> const& a, space3D::Vector_4D<T> const& b, double t) -> space3D::Vector_4D<T> {
+    return {
+        T(a.x + (b.x - a.x) * t),
+        T(a.y + (b.y - a.y) * t),
+        T(a.z + (b.z - a.z) * t),
+        T(a.w + (b.w - a.w) * t)
+    };
+}
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+template <class T>
+struct Clipped_Line {
+    Vector_4D<T> from;
+    Vector_4D<T> to;
+};
+
+/* Parametric clip, only against the planes an endpoint is outside of */
+template <class T>
+auto clip_line(Vector_4D<T> const& from, Vector_4D<T> const& to, Clip_Volume const& volume = {})
+        -> std::optional<Clipped_Line<T>> {
+    auto code_from = details::outcode(from, volume), code_to = details::outcode(to, volume);
+
+    if (code_from & code_to) {
+        return std::nullopt;
+    }
+
+    if (!(code_from | code_to)) {
+        return Clipped_Line<T>{ from, to };
+    }
+
+    auto t0 = 0.0, t1 = 1.0;
+
+    for (auto plane = 0u; plane < details::clip_planes; ++plane) {
+        if ((code_from | code_to) & (1u << plane)) {
+            auto d0 = details::plane_distance(from, plane, volume);
+            auto d1 = details::plane_distance(to, plane, volume);
+            auto t = d0 / (d0 - d1);
+
+            if (d0 < 0) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
+
+            if (t0 > t1) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    return Clipped_Line<T>{ details::clip_lerp(from, to, t0), details::clip_lerp(from, to, t1) };
+}
+
+/* Sutherland-Hodgman in clip space, count is 0 when nothing is left */
+template <class T>
+auto clip_triangle(Vector_4D<T> const& v0, Vector_4D<T> const& v1, Vector_4D<T> const& v2, Clip_Volume const& volume = {})
+        -> Clipped_Polygon<T> {
+    auto polygon = Clipped_Polygon<T>{ {{ v0, v1, v2 }}, 3 };
+
+    auto c0 = details::outcode(v0, volume), c1 = details::outcode(v1, volume), c2 = details::outcode(v2, volume);
+
+    if (c0 & c1 & c2) {
+        polygon.count = 0;
+        return polygon;
+    }
+
+    auto planes = c0 | c1 | c2;
+
+    for (auto plane = 0u; plane < details::clip_planes && polygon.count; ++plane) {
+        if (!(planes & (1u << plane))) {
+            continue;
+        }
+
+        auto input = polygon;
+        polygon.count = 0;
+
+        for (auto i = 0ul; i < input.count; ++i) {
+            auto const& current = input.vertex[i];
+            auto const& next = input.vertex[(i + 1) % input.count];
+
+            auto d0 = details::plane_distance(current, plane, volume);
+            auto d1 = details::plane_distance(next, plane, volume);
+
+            if (d0 >= 0) {
+                polygon.vertex[polygon.count++] = current;
+            }
+
+            if ((d0 < 0) != (d1 < 0)) {
+                polygon.vertex[polygon.count++] = details::clip_lerp(current, next, d0 / (d0 - d1));
+            }
+        }
+
+        if (polygon.count < 3) {
+            polygon.count = 0;
+        }
+    }
+
+    return polygon;
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_CLIP_HPP
@@ -0,0 +1,249 @@
+#ifndef CPP_ENGINE_EXPRESSION_HPP
+#define CPP_ENGINE_EXPRESSION_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vector.hpp"
+
+/**
+ * Lazy vector arithmetic. lazy(v) wraps a vector, or a span of them, and +, -, * and scale on wrapped operands
+ * build an expression instead of a temporary. Nothing runs until the expression becomes a vector (conversion or
+ * eval) or is assigned over an array, then every component is one fused expression.
+ * Nodes have no x, y, z members so the eager Dim3_Vec operators never pick them up.
+ * */
+
+namespace engine::space3D {
+
+template <class Derived>
+struct Vec_Expr;
+
+template <class E>
+concept Vec_Expression = std::derived_from<std::remove_cvref_t<E>, Vec_Expr<std::remove_cvref_t<E>>>;
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+template <std::size_t C, class V>
+constexpr auto component(V const& v) -> auto const& {
+    if constexpr (C == 0) {
+        return v.x;
+    } else if constexpr (C == 1) {
+        return v.y;
+    } else {
+        return v.z;
+    }
+}
+
+/* A single vector spans any length */
+inline constexpr auto broadcast_size = std::numeric_limits<std::size_t>::max();
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+template <class Derived>
+struct Vec_Expr {
+    /* Only expressions without an array in them become a single vector */
+    template <Dim3_Vec U>
+    constexpr operator U() const requires (!Derived::is_array) { // NOLINT(google-explicit-constructor)
+        using T = std::remove_cvref_t<decltype(std::declval<U>().x)>;
+        auto const& self = static_cast<Derived const&>(*this);
+        return U{ T(self.template get<0>(0)), T(self.template get<1>(0)), T(self.template get<2>(0)) };
+    }
+};
+
+/* Holds a reference to an lvalue and a copy of an rvalue, so lazy(u - v) stays valid */
+template <class V>
+struct Vec_Leaf : Vec_Expr<Vec_Leaf<V>> {
+    static constexpr auto is_array = false;
+
+    V vec;
+
+    template <std::size_t C>
+    constexpr auto get(std::size_t) const {
+        return details::component<C>(vec);
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return details::broadcast_size;
+    }
+};
+
+template <class T>
+struct Array_Leaf : Vec_Expr<Array_Leaf<T>> {
+    static constexpr auto is_array = true;
+
+    std::span<Vector_3D<T> const> items;
+
+    template <std::size_t C>
+    constexpr auto get(std::size_t i) const -> T {
+        return details::component<C>(items[i]);
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return std::size(items);
+    }
+};
+
+template <class Op, class L, class R>
+struct Vec_Binary : Vec_Expr<Vec_Binary<Op, L, R>> {
+    static constexpr auto is_array = L::is_array || R::is_array;
+
+    L left;
+    R right;
+
+    template <std::size_t C>
+    constexpr auto get(std::size_t i) const {
+        return Op{}(left.template get<C>(i), right.template get<C>(i));
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return std::min(left.size(), right.size());
+    }
+};
+
+template <class E, class S>
+struct Vec_Scaled : Vec_Expr<Vec_Scaled<E, S>> {
+    static constexpr auto is_array = E::is_array;
+
+    E expr;
+    S factor;
+
+    template <std::size_t C>
+    constexpr auto get(std::size_t i) const {
+        return expr.template get<C>(i) * factor;
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return expr.size();
+    }
+};
+
+template <Dim3_Vec V>
+constexpr auto lazy(V && vec) -> Vec_Leaf<V> {
+    return { {}, std::forward<V>(vec) };
+}
+
+template <class T>
+constexpr auto lazy(std::span<Vector_3D<T> const> items) -> Array_Leaf<T> {
+    return { {}, items };
+}
+
+template <class T>
+constexpr auto lazy(std::span<Vector_3D<T>> items) -> Array_Leaf<T> {
+    return { {}, items };
+}
+
+template <class T, class Allocator>
+constexpr auto lazy(std::vector<Vector_3D<T>, Allocator> const& items) -> Array_Leaf<T> {
+    return { {}, items };
+}
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+/* A plain vector next to an expression is wrapped, an expression is taken as is */
+template <class E>
+constexpr auto as_expression(E && e) {
+    if constexpr (space3D::Vec_Expression<E>) {
+        return std::remove_cvref_t<E>(std::forward<E>(e));
+    } else {
+        return space3D::lazy(std::forward<E>(e));
+    }
+}
+
+template <class L, class R>
+concept Lazy_Operands = (space3D::Vec_Expression<L> || space3D::Vec_Expression<R>)
+                        && (space3D::Vec_Expression<L> || space3D::Dim3_Vec<L>)
+                        && (space3D::Vec_Expression<R> || space3D::Dim3_Vec<R>);
+
+template <class Op, class L, class R>
+constexpr auto make_binary(L && left, R && right) {
+    using Left = decltype(as_expression(std::forward<L>(left)));
+    using Right = decltype(as_expression(std::forward<R>(right)));
+
+    return space3D::Vec_Binary<Op, Left, Right>{ {}, as_expression(std::forward<L>(left)), as_expression(std::forward<R>(right)) };
+}
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+template <class L, class R> requires details::Lazy_Operands<L, R>
+constexpr auto operator+(L && left, R && right) {
+    return details::make_binary<std::plus<>>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template <class L, class R> requires details::Lazy_Operands<L, R>
+constexpr auto operator-(L && left, R && right) {
+    return details::make_binary<std::minus<>>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template <Vec_Expression E, Number S>
+constexpr auto scale(E && expr, S factor) {
+    return Vec_Scaled<std::remove_cvref_t<E>, S>{ {}, std::forward<E>(expr), factor };
+}
+
+template <Vec_Expression E, Number S>
+constexpr auto operator*(E && expr, S factor) {
+    return scale(std::forward<E>(expr), factor);
+}
+
+template <Number S, Vec_Expression E>
+constexpr auto operator*(S factor, E && expr) {
+    return scale(std::forward<E>(expr), factor);
+}
+
+template <Vec_Expression E>
+constexpr auto operator-(E && expr) {
+    return scale(std::forward<E>(expr), -1);
+}
+
+/* Both sides are walked once per component, no vector is built for either */
+template <class L, class R> requires details::Lazy_Operands<L, R>
+constexpr auto dot_product(L && left, R && right) {
+    auto l = details::as_expression(std::forward<L>(left));
+    auto r = details::as_expression(std::forward<R>(right));
+    static_assert(!decltype(l)::is_array && !decltype(r)::is_array, "dot_product of single vectors only");
+
+    return l.template get<0>(0) * r.template get<0>(0)
+         + l.template get<1>(0) * r.template get<1>(0)
+         + l.template get<2>(0) * r.template get<2>(0);
+}
+
+template <Vec_Expression E> requires (!std::remove_cvref_t<E>::is_array)
+constexpr auto eval(E const& expr) {
+    using T = std::remove_cvref_t<decltype(expr.template get<0>(0))>;
+    return Vector_3D<T>{ expr.template get<0>(0), expr.template get<1>(0), expr.template get<2>(0) };
+}
+
+/**
+ * out[i] = expr at i for the shortest array in expr. One loop, the three components of a vertex are read before
+ * it is written so out may be one of the operands.
+ * */
+template <class T, Vec_Expression E>
+constexpr auto assign(std::span<Vector_3D<T>> out, E const& expr) -> void {
+    auto count = std::min(std::size(out), expr.size());
+
+    for (auto i = 0ul; i < count; ++i) {
+        auto x = T(expr.template get<0>(i));
+        auto y = T(expr.template get<1>(i));
+        auto z = T(expr.template get<2>(i));
+
+        out[i] = { x, y, z };
+    }
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_EXPRESSION_HPP
@@ -0,0 +1,191 @@
+#ifndef CPP_ENGINE_QUATERNION_HPP
+#define CPP_ENGINE_QUATERNION_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "../axis.hpp"
+#include "../trig.hpp"
+#include "vector.hpp"
+#include "affine.hpp"
+
+namespace engine::space3D {
+
+/**
+ * Unit quaternion orientation, w + v. Composition is a product, so an entity can keep one and turn it step by
+ * step without going back to angles. It is a tagged transform, joins a Translation * Scaling chain as is and
+ * becomes a Mat4 once per frame.
+ * The vector part is not named x, y, z so the Dim3_Vec helpers never take a quaternion for a vector.
+ * */
+template <class T = double>
+struct Quaternion : Tagged_Transform<Quaternion<T>> {
+    T w;
+    Vector_3D<T> v;
+
+    constexpr Quaternion() : w{ 1 }, v{ 0, 0, 0 } {}
+
+    constexpr Quaternion(T w, Vector_3D<T> const& v) : w{ w }, v{ v } {}
+
+    static constexpr auto identity() -> Quaternion {
+        return {};
+    }
+
+    /* axis has to be unit length, angle in radians turning counter-clockwise about it */
+    static auto axis_angle(Vector_3D<T> const& axis, double angle) -> Quaternion {
+        return from_half_angle(axis, sincos(angle / 2));
+    }
+
+    /* Whole degrees come from the half degree table */
+    static auto axis_angle(Vector_3D<T> const& axis, Degrees angle) -> Quaternion {
+        return from_half_angle(axis, sincos(Degrees{ angle.value / 2 }));
+    }
+
+    /* Same turn as Mat4::rotate about each axis */
+    template <class Angle>
+    static auto rotate(axis::X_t, Angle angle) -> Quaternion {
+        return axis_angle({ 1, 0, 0 }, -angle);
+    }
+
+    template <class Angle>
+    static auto rotate(axis::Y_t, Angle angle) -> Quaternion {
+        return axis_angle({ 0, 1, 0 }, angle);
+    }
+
+    template <class Angle>
+    static auto rotate(axis::Z_t, Angle angle) -> Quaternion {
+        return axis_angle({ 0, 0, 1 }, -angle);
+    }
+
+    [[nodiscard]] constexpr auto affine() const -> Affine {
+        auto [ x, y, z ] = Vector_3D<double>{ double(v.x), double(v.y), double(v.z) };
+        auto s = double(w);
+
+        return {
+            {{
+                { 1 - 2 * (y * y + z * z), 2 * (x * y - s * z),     2 * (x * z + s * y)     },
+                { 2 * (x * y + s * z),     1 - 2 * (x * x + z * z), 2 * (y * z - s * x)     },
+                { 2 * (x * z - s * y),     2 * (y * z + s * x),     1 - 2 * (x * x + y * y) }
+            }},
+            { 0, 0, 0 }
+        };
+    }
+
+private:
+    static constexpr auto from_half_angle(Vector_3D<T> const& axis, Sin_Cos<double> const& half) -> Quaternion {
+        return { T(half.cos), { T(axis.x * half.sin), T(axis.y * half.sin), T(axis.z * half.sin) } };
+    }
+};
+
+using Quaternionf = Quaternion<float>;
+using Quaterniond = Quaternion<double>;
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+template <class T>
+constexpr auto cross(space3D::Vector_3D<T> const& u, space3D::Vector_3D<T> const& v) -> space3D::Vector_3D<T> {
+    return { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+}
+
+template <class T>
+constexpr auto weighted_sum(space3D::Quaternion<T> const& a, T ka, space3D::Quaternion<T> const& b, T kb)
+        -> space3D::Quaternion<T> {
+    return {
+        a.w * ka + b.w * kb,
+        { a.v.x * ka + b.v.x * kb, a.v.y * ka + b.v.y * kb, a.v.z * ka + b.v.z * kb }
+    };
+}
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+/* left * right turns by right first, the same order as Mat4 */
+template <class T>
+constexpr auto operator*(Quaternion<T> const& left, Quaternion<T> const& right) -> Quaternion<T> {
+    auto a = left.w, b = right.w;
+    auto const& u = left.v;
+    auto const& v = right.v;
+    auto c = details::cross(u, v);
+
+    return {
+        a * b - dot_product(u, v),
+        { a * v.x + b * u.x + c.x, a * v.y + b * u.y + c.y, a * v.z + b * u.z + c.z }
+    };
+}
+
+template <class T>
+constexpr auto conjugate(Quaternion<T> const& q) -> Quaternion<T> {
+    return { q.w, { -q.v.x, -q.v.y, -q.v.z } };
+}
+
+template <class T>
+constexpr auto dot_product(Quaternion<T> const& a, Quaternion<T> const& b) -> T {
+    return a.w * b.w + dot_product(a.v, b.v);
+}
+
+template <class T>
+auto magnitude(Quaternion<T> const& q) -> T {
+    return std::sqrt(dot_product(q, q));
+}
+
+/* Products drift off unit length slowly, renormalize after a run of them */
+template <class T>
+auto normalize(Quaternion<T> const& q) -> Quaternion<T> {
+    if (auto mag = magnitude(q); mag > 0) {
+        auto inv = 1 / mag;
+        return { q.w * inv, { q.v.x * inv, q.v.y * inv, q.v.z * inv } };
+    }
+
+    return {};
+}
+
+/* Straight line between the two then back on the sphere, along the shorter arc. Cheap, speed is not constant */
+template <class T>
+auto nlerp(Quaternion<T> const& from, Quaternion<T> const& to, T t) -> Quaternion<T> {
+    auto sign = dot_product(from, to) < 0 ? T(-1) : T(1);
+    return normalize(details::weighted_sum(from, 1 - t, to, sign * t));
+}
+
+/* Constant angular speed along the shorter arc, nlerp once the two are close enough that the angle is noise */
+template <class T>
+auto slerp(Quaternion<T> const& from, Quaternion<T> const& to, T t) -> Quaternion<T> {
+    auto cosine = dot_product(from, to);
+    auto sign = cosine < 0 ? T(-1) : T(1);
+    cosine = std::min(cosine * sign, T(1));
+
+    if (cosine > T(0.9995)) {
+        return nlerp(from, to, t);
+    }
+
+    auto angle = std::acos(cosine);
+    auto r = 1 / std::sin(angle);
+
+    return details::weighted_sum(from, T(std::sin((1 - t) * angle) * r), to, T(sign * std::sin(t * angle) * r));
+}
+
+/**
+ * One step of dq/dt = 1/2 omega q, omega the angular velocity in radians per second about fixed axes.
+ * No trigonometry, the result is renormalized.
+ * */
+template <class T>
+auto integrate(Quaternion<T> const& q, Vector_3D<T> const& omega, T seconds) -> Quaternion<T> {
+    auto spin = Quaternion<T>{ 0, omega } * q;
+    return normalize(details::weighted_sum(q, T(1), spin, seconds / 2));
+}
+
+/* Rotates without building the matrix, v' = v + w t + u x t with t = 2 u x v */
+template <class U, class T>
+auto operator*(Vector_3D<U> const& vec, Quaternion<T> const& q) -> Vector_3D<U> {
+    auto p = Vector_3D<T>{ T(vec.x), T(vec.y), T(vec.z) };
+    auto t = details::cross(q.v, p);
+    t = { 2 * t.x, 2 * t.y, 2 * t.z };
+    auto c = details::cross(q.v, t);
+
+    return { U(p.x + q.w * t.x + c.x), U(p.y + q.w * t.y + c.y), U(p.z + q.w * t.z + c.z) };
+}
+
+} // namespace engine::space3D
+
+#endif //CPP_ENGINE_QUATERNION_HPP
@@ -3,12 +3,32 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <tuple>
 #include <vector>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <span>
 
 #include "vector.hpp"
+#include "../2d/vector.hpp"
+#include "bounds.hpp"
+
+namespace engine::details {
+
+/* Unique across the process, so two solids only share a topology generation when one is a copy of the other */
+inline auto next_topology_generation() -> std::uint64_t {
+    static auto counter = std::atomic<std::uint64_t>{};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace engine::details
 
 namespace engine::space3D {
 
@@ -18,13 +38,162 @@ struct Tetrahedron {
 };
 
 template <class T>
-struct Solid {
+struct Triangle_3D {
+    std::array<Vector_3D<T>, 3> vertex;
+};
+
+template <class T>
+class Solid {
+public:
     struct Face_Indexer {
         std::vector<std::size_t> indexes;
+
+        /* One based like indexes, 0 for a corner without one, empty when no corner has one */
+        std::vector<std::size_t> texture = {};
+        std::vector<std::size_t> normal = {};
+    };
+
+    /**
+     * Undirected edge shared by one or more faces, zero based, keeps the direction it was first seen with. A
+     * wireframe drawn from edges walks each shared edge once in that direction, where the faces walk it both ways.
+     * */
+    struct Edge {
+        std::size_t from;
+        std::size_t to;
     };
 
-    std::vector<Vector_3D<T>> vertex;
-    std::vector<Face_Indexer> faces;
+    /* Texture coordinates and normals, faces refer to them per corner */
+    std::vector<space2D::Vector_2D<T>> uv = {};
+    std::vector<Vector_3D<T>> normal = {};
+
+    /* Unique edges cache, empty until update_edges() and dropped whenever faces change */
+    std::vector<Edge> edges = {};
+
+    /* Box and sphere cache, empty until update_bounds() and dropped whenever vertices change */
+    std::optional<Bounds<T>> bounds = {};
+
+    /* Vertices change only through add_vertex(), assign_vertices() and edit_vertices(), each drops bounds */
+    [[nodiscard]] auto vertex() const -> std::vector<Vector_3D<T>> const& {
+        return m_vertex;
+    }
+
+    auto add_vertex(Vector_3D<T> const& v) -> void {
+        m_vertex.push_back(v);
+        invalidate_bounds();
+    }
+
+    auto assign_vertices(std::vector<Vector_3D<T>> vertex) -> void {
+        m_vertex = std::move(vertex);
+        invalidate_bounds();
+    }
+
+    /* edit(span) rewrites the vertices in place, the count stays and bounds are dropped once it returns */
+    template <class Edit>
+    auto edit_vertices(Edit && edit) -> void {
+        edit(std::span<Vector_3D<T>>{ m_vertex });
+        invalidate_bounds();
+    }
+
+    /* Faces change only through add_face() and assign_faces(), so edges never outlive the faces they came from */
+    [[nodiscard]] auto faces() const -> std::vector<Face_Indexer> const& {
+        return m_faces;
+    }
+
+    auto add_face(Face_Indexer face) -> void {
+        m_faces.push_back(std::move(face));
+        invalidate_edges();
+    }
+
+    auto assign_faces(std::vector<Face_Indexer> faces) -> void {
+        m_faces = std::move(faces);
+        invalidate_edges();
+    }
+
+    /* Changes whenever faces or edges do, caches derived from both key on it */
+    [[nodiscard]] auto topology_generation() const -> std::uint64_t {
+        return m_generation;
+    }
+
+    auto invalidate_bounds() -> void {
+        bounds.reset();
+    }
+
+    auto update_bounds() -> Bounds<T> const& {
+        bounds = compute_bounds<T>(m_vertex);
+        return *bounds;
+    }
+
+    /* The cached volumes, or a fresh pass when a const solid has none yet */
+    [[nodiscard]] auto bounding_volumes() const -> Bounds<T> {
+        return bounds ? *bounds : compute_bounds<T>(m_vertex);
+    }
+
+    [[nodiscard]] auto bounding_box() const -> Aabb<T> {
+        return bounding_volumes().box;
+    }
+
+    [[nodiscard]] auto bounding_sphere() const -> Bounding_Sphere<T> {
+        return bounding_volumes().sphere;
+    }
+
+    auto invalidate_edges() -> void {
+        edges.clear();
+        m_generation = details::next_topology_generation();
+    }
+
+    auto update_edges() -> void {
+        update_edges(std::execution::seq);
+    }
+
+    /* The sorts run under policy, keys are unique so every policy gives the same edges */
+    template <class Policy>
+    auto update_edges(Policy && policy) -> void {
+        struct Keyed_Edge {
+            std::size_t low, high;
+            std::size_t order;
+            Edge edge;
+        };
+
+        auto keyed = std::vector<Keyed_Edge>{};
+
+        for (auto const& face : m_faces) {
+            auto const& indexes = face.indexes;
+
+            if (std::size(indexes) > 2) {
+                for (auto i = 0ul; i < std::size(indexes); ++i) {
+                    auto from = indexes[i] - 1, to = indexes[(i + 1) % std::size(indexes)] - 1;
+                    keyed.push_back({ std::min(from, to), std::max(from, to), std::size(keyed), { from, to } });
+                }
+            }
+        }
+
+        /* group shared edges keeping the first occurrence, then restore the face walk order */
+        auto by_key = [](auto const& l, auto const& r) {
+            return std::tie(l.low, l.high, l.order) < std::tie(r.low, r.high, r.order);
+        };
+        auto same_key = [](auto const& l, auto const& r) {
+            return l.low == r.low && l.high == r.high;
+        };
+
+        auto by_order = [](auto const& l, auto const& r) {
+            return l.order < r.order;
+        };
+
+        std::sort(policy, std::begin(keyed), std::end(keyed), by_key);
+        keyed.erase(std::unique(policy, std::begin(keyed), std::end(keyed), same_key), std::end(keyed));
+        std::sort(policy, std::begin(keyed), std::end(keyed), by_order);
+
+        edges.resize(std::size(keyed));
+        std::transform(policy, std::cbegin(keyed), std::cend(keyed), std::begin(edges), [](auto const& k) {
+            return k.edge;
+        });
+        m_generation = details::next_topology_generation();
+    }
+
+private:
+    std::vector<Vector_3D<T>> m_vertex;
+    std::vector<Face_Indexer> m_faces;
+    std::uint64_t m_generation = details::next_topology_generation();
 };
 
 } // namespace engine::space3D
@@ -2,106 +2,436 @@
 #define CPP_ENGINE_TRANSFORM_HPP
 
 #include <cmath>
+#include <concepts>
 #include <numbers>
+#include <optional>
+#include <type_traits>
 
 #include "../axis.hpp"
 #include "../transform_base.hpp"
+#include "../trig.hpp"
 #include "../../utility/accessors.hpp"
+#include "../../utility/cpu.hpp"
 
 namespace engine::space3D {
 
 using engine::operator*; /* so ADL catches from Mat4 usage */
 
-struct Mat4 : Accessors_For<Mat4> {
-    using mat4_t = std::array<std::array<double, 4>, 4>;
+/**
+ * 4x4 transform on scalar S, stored in Layout order and aligned so rows (or columns) load as vectors.
+ * Factories take the rows in math order whatever the layout, at(row, column) reads them back the same way.
+ * */
+template <class S = double, Matrix_Layout Layout = Row_Major>
+struct Basic_Mat4 : Accessors_For<Basic_Mat4<S, Layout>> {
+    using scalar_type = S;
+    using layout_type = Layout;
+    using mat4_t = std::array<std::array<S, 4>, 4>;
 
-    mat4_t container;
+    alignas(details::matrix_alignment<S, 4>) mat4_t container;
+
+    [[nodiscard]] constexpr auto at(std::size_t row, std::size_t column) const -> S {
+        if constexpr (std::same_as<Layout, Row_Major>) {
+            return container[row][column];
+        } else {
+            return container[column][row];
+        }
+    }
+
+    static constexpr auto from_rows(details::Square<double, 4> const& rows) -> Basic_Mat4 {
+        auto out = Basic_Mat4{};
+        out.container = details::from_rows<S, 4, Layout>(rows);
+        return out;
+    }
 
     static inline double const default_fov = 1 / std::tan(90 / 2.0 * std::numbers::pi / 180);
 
-    static auto identity() -> Mat4 {
-        return /*Mat4*/ { .container = {{
+    static constexpr auto identity() -> Basic_Mat4 {
+        return from_rows({{
             { 1, 0, 0, 0 },
             { 0, 1, 0, 0 },
             { 0, 0, 1, 0 },
             { 0, 0, 0, 1 },
-        }}};
+        }});
     }
 
-    static auto translate(double dx, double dy, double dz) -> Mat4 {
-        return /*Mat4*/ { .container = {{
+    static constexpr auto translate(double dx, double dy, double dz) -> Basic_Mat4 {
+        return from_rows({{
             { 1, 0, 0, dx },
             { 0, 1, 0, dy },
             { 0, 0, 1, dz },
             { 0, 0, 0, 1  },
-        }}};
+        }});
     }
 
-    static auto scale(double dx, double dy, double dz) -> Mat4 {
-        return /*Mat4*/ { .container = {{
+    static constexpr auto scale(double dx, double dy, double dz) -> Basic_Mat4 {
+        return from_rows({{
             { dx, 0,  0,  0 },
             { 0,  dy, 0,  0 },
             { 0,  0,  dz, 0 },
             { 0,  0,  0,  1 },
-        }}};
+        }});
+    }
+
+    template <axis::Axis A>
+    static auto rotate(A axis, double angle) -> Basic_Mat4 {
+        return rotate(axis, sincos(angle));
+    }
+
+    /* Whole and half degrees come from a table */
+    template <axis::Axis A>
+    static auto rotate(A axis, Degrees angle) -> Basic_Mat4 {
+        return rotate(axis, sincos(angle));
     }
 
-    static auto rotate(axis::X_t, double angle) -> Mat4 {
-        return /*Mat4*/ { .container = {{
-            { 1,                0,               0,  0 },
-            { 0,  std::cos(angle),  std::sin(angle), 0 },
-            { 0, -std::sin(angle), std::cos(angle),  0 },
-            { 0,                0,               0,  1 }
-        }}};
+    static constexpr auto rotate(axis::X_t, Sin_Cos<double> const& angle) -> Basic_Mat4 {
+        auto [ s, c ] = angle;
+
+        return from_rows({{
+            { 1,  0, 0, 0 },
+            { 0,  c, s, 0 },
+            { 0, -s, c, 0 },
+            { 0,  0, 0, 1 }
+        }});
     }
 
-    static auto rotate(axis::Y_t, double angle) -> Mat4 {
-        return /*Mat4*/ { .container = {{
-            { std::cos(angle),  0, std::sin(angle), 0 },
-            { 0,                1,               0, 0 },
-            { -std::sin(angle), 0, std::cos(angle), 0 },
-            { 0,                0,               0, 1 }
-        }}};
+    static constexpr auto rotate(axis::Y_t, Sin_Cos<double> const& angle) -> Basic_Mat4 {
+        auto [ s, c ] = angle;
+
+        return from_rows({{
+            { c,  0, s, 0 },
+            { 0,  1, 0, 0 },
+            { -s, 0, c, 0 },
+            { 0,  0, 0, 1 }
+        }});
     }
 
-    static auto rotate(axis::Z_t, double angle) -> Mat4 {
-        return /*Mat4*/ { .container = {{
-            { std::cos(angle),  std::sin(angle), 0, 0 },
-            { -std::sin(angle), std::cos(angle), 0, 0 },
-            { 0,                0,               1, 0 },
-            { 0,                0,               0, 1 }
-        }}};
+    static constexpr auto rotate(axis::Z_t, Sin_Cos<double> const& angle) -> Basic_Mat4 {
+        auto [ s, c ] = angle;
+
+        return from_rows({{
+            { c,  s, 0, 0 },
+            { -s, c, 0, 0 },
+            { 0,  0, 1, 0 },
+            { 0,  0, 0, 1 }
+        }});
     }
 
-    static auto simple_perspective(double cp) -> Mat4 {
-        return /*Mat4*/{ .container = {{
+    static auto simple_perspective(double cp) -> Basic_Mat4 {
+        return from_rows({{
            { 1, 0, 0,      0 },
            { 0, 1, 0,      0 },
            { 0, 0, 0,      0 },
            { 0, 0, 1 / cp, 1 },
-        }}};
+        }});
     }
 
-    static auto simple_perspective(double n, double q, double a = 1, double f = default_fov) -> Mat4 {
-        return /*Mat4*/{ .container = {{
+    static auto simple_perspective(double n, double q, double a = 1, double f = default_fov) -> Basic_Mat4 {
+        return from_rows({{
             { a * f, 0, 0,           0 },
             { 0,     f, 0,           0 },
             { 0,     0, q,           1 },
             { 0,     0, -(n * q), 0 },
-        }}};
+        }});
     }
 };
 
-template <class T>
-auto apply_transform(Vector_3D<T> const& vec, Mat4 const& transform) -> Vector_3D<T> {
-    auto out = Vector_3D <T> {
-        T(vec.x * transform[0][0] + vec.y * transform[0][1] + vec.z * transform[0][2] + /*vec.w **/ transform[0][3]),
-        T(vec.x * transform[1][0] + vec.y * transform[1][1] + vec.z * transform[1][2] + /*vec.w **/ transform[1][3]),
-        T(vec.x * transform[2][0] + vec.y * transform[2][1] + vec.z * transform[2][2] + /*vec.w **/ transform[2][3])
+using Mat4 = Basic_Mat4<double>;
+using Mat4f = Basic_Mat4<float>;
+
+} // namespace engine::space3D
+
+namespace engine::details {
+
+/* Scalar inverse of the storage from 2x2 sub-determinants, inverse(M^T) = inverse(M)^T so any layout works */
+template <class S>
+auto inverse_storage(Square<S, 4> const& m) -> std::optional<Square<S, 4>> {
+    auto s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    auto s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    auto s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    auto s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    auto s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    auto s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+    auto c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    auto c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    auto c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    auto c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    auto c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    auto c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+    auto det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+    if (det == S(0)) {
+        return std::nullopt;
+    }
+
+    auto r = S(1) / det;
+
+    return Square<S, 4>{{
+        { ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * r, (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * r,
+          ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * r, (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * r },
+        { (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * r, ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * r,
+          (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * r, ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * r },
+        { ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * r, (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * r,
+          ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * r, (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * r },
+        { (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * r, ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * r,
+          (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * r, ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * r }
+    }};
+}
+
+#if defined(CPP_ENGINE_X86)
+
+/* Aligned loads, only for Basic_Mat4 storage. Row i of the product is the rows of right weighted by row i of left, summed in the scalar order */
+CPP_ENGINE_TARGET_SSE2
+inline auto multiply_storage_sse2(Square<float, 4> const& left, Square<float, 4> const& right) -> Square<float, 4> {
+    auto product = Square<float, 4>{};
+
+    auto r0 = _mm_load_ps(std::data(right[0])), r1 = _mm_load_ps(std::data(right[1]));
+    auto r2 = _mm_load_ps(std::data(right[2])), r3 = _mm_load_ps(std::data(right[3]));
+
+    for (auto i = 0u; i < 4; ++i) {
+        auto sum = _mm_mul_ps(_mm_set1_ps(left[i][0]), r0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(left[i][1]), r1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(left[i][2]), r2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(left[i][3]), r3));
+        _mm_storeu_ps(std::data(product[i]), sum);
+    }
+
+    return product;
+}
+
+/* Same broadcast for double, one row per AVX register. No FMA, so the bits match the scalar product */
+CPP_ENGINE_TARGET_AVX2
+inline auto multiply_storage_avx2(Square<double, 4> const& left, Square<double, 4> const& right) -> Square<double, 4> {
+    auto product = Square<double, 4>{};
+
+    auto r0 = _mm256_load_pd(std::data(right[0])), r1 = _mm256_load_pd(std::data(right[1]));
+    auto r2 = _mm256_load_pd(std::data(right[2])), r3 = _mm256_load_pd(std::data(right[3]));
+
+    for (auto i = 0u; i < 4; ++i) {
+        auto sum = _mm256_mul_pd(_mm256_set1_pd(left[i][0]), r0);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(left[i][1]), r1));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(left[i][2]), r2));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(left[i][3]), r3));
+        _mm256_storeu_pd(std::data(product[i]), sum);
+    }
+
+    return product;
+}
+
+CPP_ENGINE_TARGET_SSE2
+inline auto transpose_storage_sse2(Square<float, 4> const& m) -> Square<float, 4> {
+    auto out = Square<float, 4>{};
+
+    auto r0 = _mm_load_ps(std::data(m[0])), r1 = _mm_load_ps(std::data(m[1]));
+    auto r2 = _mm_load_ps(std::data(m[2])), r3 = _mm_load_ps(std::data(m[3]));
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(std::data(out[0]), r0);
+    _mm_storeu_ps(std::data(out[1]), r1);
+    _mm_storeu_ps(std::data(out[2]), r2);
+    _mm_storeu_ps(std::data(out[3]), r3);
+
+    return out;
+}
+
+/* 2x2 blocks packed as (m00, m01, m10, m11) */
+template <int X, int Y, int Z, int W>
+CPP_ENGINE_TARGET_SSE2
+inline auto swizzle(__m128 v) -> __m128 {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/* A * B */
+CPP_ENGINE_TARGET_SSE2
+inline auto block_mul(__m128 a, __m128 b) -> __m128 {
+    return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/* adj(A) * B */
+CPP_ENGINE_TARGET_SSE2
+inline auto block_adj_mul(__m128 a, __m128 b) -> __m128 {
+    return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+
+/* A * adj(B) */
+CPP_ENGINE_TARGET_SSE2
+inline auto block_mul_adj(__m128 a, __m128 b) -> __m128 {
+    return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/* Block-wise inverse of [A B; C D] through 2x2 adjugates */
+CPP_ENGINE_TARGET_SSE2
+inline auto inverse_storage_sse2(Square<float, 4> const& m) -> std::optional<Square<float, 4>> {
+    auto r0 = _mm_load_ps(std::data(m[0])), r1 = _mm_load_ps(std::data(m[1]));
+    auto r2 = _mm_load_ps(std::data(m[2])), r3 = _mm_load_ps(std::data(m[3]));
+
+    auto a = _mm_movelh_ps(r0, r1), b = _mm_movehl_ps(r1, r0);
+    auto c = _mm_movelh_ps(r2, r3), d = _mm_movehl_ps(r3, r2);
+
+    /* |A| |B| |C| |D| */
+    auto det_sub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)))
+    );
+
+    auto det_a = swizzle<0, 0, 0, 0>(det_sub), det_b = swizzle<1, 1, 1, 1>(det_sub);
+    auto det_c = swizzle<2, 2, 2, 2>(det_sub), det_d = swizzle<3, 3, 3, 3>(det_sub);
+
+    auto d_c = block_adj_mul(d, c);
+    auto a_b = block_adj_mul(a, b);
+
+    auto x = _mm_sub_ps(_mm_mul_ps(det_d, a), block_mul(b, d_c));
+    auto w = _mm_sub_ps(_mm_mul_ps(det_a, d), block_mul(c, a_b));
+    auto y = _mm_sub_ps(_mm_mul_ps(det_b, c), block_mul_adj(d, a_b));
+    auto z = _mm_sub_ps(_mm_mul_ps(det_c, b), block_mul_adj(a, d_c));
+
+    /* |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C) */
+    auto trace = _mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c));
+    trace = _mm_add_ps(trace, swizzle<2, 3, 0, 1>(trace));
+    trace = _mm_add_ps(trace, swizzle<1, 0, 3, 2>(trace));
+
+    auto det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+    if (_mm_cvtss_f32(det) == 0.0f) {
+        return std::nullopt;
+    }
+
+    auto r = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+    x = _mm_mul_ps(x, r);
+    y = _mm_mul_ps(y, r);
+    z = _mm_mul_ps(z, r);
+    w = _mm_mul_ps(w, r);
+
+    auto out = Square<float, 4>{};
+
+    /* adjugate of each block folded into the store shuffle */
+    _mm_storeu_ps(std::data(out[0]), _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(std::data(out[1]), _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(std::data(out[2]), _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(std::data(out[3]), _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+    return out;
+}
+
+#endif
+
+} // namespace engine::details
+
+namespace engine::space3D {
+
+/* Unrolled scalar product in constant evaluation, the vector kernels at run time */
+template <class S, class L>
+constexpr auto operator*(Basic_Mat4<S, L> const& left, Basic_Mat4<S, L> const& right) -> Basic_Mat4<S, L> {
+    /* column-major storage holds the transpose, (AB)^T = B^T A^T */
+    auto const& first = std::same_as<L, Row_Major> ? left : right;
+    auto const& second = std::same_as<L, Row_Major> ? right : left;
+
+    auto product = Basic_Mat4<S, L>{};
+
+#if defined(CPP_ENGINE_X86)
+    if (!std::is_constant_evaluated()) {
+        if constexpr (std::same_as<S, float>) {
+            if (cpu::features().sse2) {
+                product.container = details::multiply_storage_sse2(first.container, second.container);
+                return product;
+            }
+        } else if constexpr (std::same_as<S, double>) {
+            if (cpu::features().avx2) {
+                product.container = details::multiply_storage_avx2(first.container, second.container);
+                return product;
+            }
+        }
+    }
+#endif
+
+    product.container = details::multiply_storage(first.container, second.container);
+    return product;
+}
+
+template <class S, class L>
+auto transpose(Basic_Mat4<S, L> const& m) -> Basic_Mat4<S, L> {
+    auto out = Basic_Mat4<S, L>{};
+
+#if defined(CPP_ENGINE_X86)
+    if constexpr (std::same_as<S, float>) {
+        if (cpu::features().sse2) {
+            out.container = details::transpose_storage_sse2(m.container);
+            return out;
+        }
+    }
+#endif
+
+    out.container = details::transpose_storage(m.container);
+    return out;
+}
+
+/* Empty when singular */
+template <class S, class L>
+auto inverse(Basic_Mat4<S, L> const& m) -> std::optional<Basic_Mat4<S, L>> {
+    auto storage = [&m] {
+#if defined(CPP_ENGINE_X86)
+        if constexpr (std::same_as<S, float>) {
+            if (cpu::features().sse2) {
+                return details::inverse_storage_sse2(m.container);
+            }
+        }
+#endif
+        return details::inverse_storage(m.container);
+    }();
+
+    if (!storage) {
+        return std::nullopt;
+    }
+
+    auto out = Basic_Mat4<S, L>{};
+    out.container = *storage;
+    return out;
+}
+
+/* Same transform in another scalar or storage order */
+template <class To, class S, class L>
+auto matrix_cast(Basic_Mat4<S, L> const& m) -> To {
+    auto rows = details::Square<double, 4>{};
+
+    for (auto i = 0u; i < 4; ++i) {
+        for (auto j = 0u; j < 4; ++j) {
+            rows[i][j] = double(m.at(i, j));
+        }
+    }
+
+    return To::from_rows(rows);
+}
+
+/* Clip space result, nothing is divided */
+template <class T, class S, class L>
+auto apply_projective(Vector_4D<T> const& vec, Basic_Mat4<S, L> const& transform) -> Vector_4D<T> {
+    return {
+        T(vec.x * transform.at(0, 0) + vec.y * transform.at(0, 1) + vec.z * transform.at(0, 2) + vec.w * transform.at(0, 3)),
+        T(vec.x * transform.at(1, 0) + vec.y * transform.at(1, 1) + vec.z * transform.at(1, 2) + vec.w * transform.at(1, 3)),
+        T(vec.x * transform.at(2, 0) + vec.y * transform.at(2, 1) + vec.z * transform.at(2, 2) + vec.w * transform.at(2, 3)),
+        T(vec.x * transform.at(3, 0) + vec.y * transform.at(3, 1) + vec.z * transform.at(3, 2) + vec.w * transform.at(3, 3))
     };
+}
 
-    if (auto w = T(vec.x * transform[3][0] + vec.y * transform[3][1] + vec.z * transform[3][2] + /*vec.w **/ transform[3][3]);
-        w != T(0)) {
+template <class T, class S, class L>
+auto apply_projective(Vector_3D<T> const& vec, Basic_Mat4<S, L> const& transform) -> Vector_4D<T> {
+    return {
+        T(vec.x * transform.at(0, 0) + vec.y * transform.at(0, 1) + vec.z * transform.at(0, 2) + /*vec.w **/ transform.at(0, 3)),
+        T(vec.x * transform.at(1, 0) + vec.y * transform.at(1, 1) + vec.z * transform.at(1, 2) + /*vec.w **/ transform.at(1, 3)),
+        T(vec.x * transform.at(2, 0) + vec.y * transform.at(2, 1) + vec.z * transform.at(2, 2) + /*vec.w **/ transform.at(2, 3)),
+        T(vec.x * transform.at(3, 0) + vec.y * transform.at(3, 1) + vec.z * transform.at(3, 2) + /*vec.w **/ transform.at(3, 3))
+    };
+}
+
+/* Points on the w = 0 plane are left undivided */
+template <class T>
+auto perspective_divide(Vector_4D<T> const& vec) -> Vector_3D<T> {
+    auto out = Vector_3D<T>{ vec.x, vec.y, vec.z };
+
+    if (auto w = vec.w; w != T(0)) {
         out.x /= w;
         out.y /= w;
         out.z /= w;
@@ -110,11 +440,22 @@ auto apply_transform(Vector_3D<T> const& vec, Mat4 const& transform) -> Vector_3
     return out;
 }
 
-template <class T>
-auto operator*(Vector_3D<T> const& vec, Mat4 const& transform) -> Vector_3D<T> {
+/* Divides right away, so points behind the eye flip over. Clip primitives in clip space when that can happen */
+template <class T, class S, class L>
+auto apply_transform(Vector_3D<T> const& vec, Basic_Mat4<S, L> const& transform) -> Vector_3D<T> {
+    return perspective_divide(apply_projective(vec, transform));
+}
+
+template <class T, class S, class L>
+auto operator*(Vector_3D<T> const& vec, Basic_Mat4<S, L> const& transform) -> Vector_3D<T> {
     return apply_transform(vec, transform);
 }
 
+template <class T, class S, class L>
+auto operator*(Vector_4D<T> const& vec, Basic_Mat4<S, L> const& transform) -> Vector_4D<T> {
+    return apply_projective(vec, transform);
+}
+
 template <Dim3_Vec U, class T>
 auto scale(U const& u, T a) -> U {
     return { u.x * a, u.y * a, u.z * a };
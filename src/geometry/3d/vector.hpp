@@ -23,10 +23,21 @@ struct Vector_3D {
     T z;
 };
 
+/* Homogeneous point, w is kept until primitives are clipped */
+template <Number T>
+struct Vector_4D {
+    T x;
+    T y;
+    T z;
+    T w;
+};
+
 /* Shorthands */
 using Vector_3Di = Vector_3D<int>;
 using Vector_3Df = Vector_3D<float>;
 using Vector_3Dd = Vector_3D<double>;
+using Vector_4Df = Vector_4D<float>;
+using Vector_4Dd = Vector_4D<double>;
 
 /* Utility */
 template <Dim3_Vec U, Dim3_Vec V>
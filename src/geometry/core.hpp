@@ -5,6 +5,7 @@
 
 #include "transform_base.hpp"
 #include "axis.hpp"
+#include "trig.hpp"
 
 /* 2D imports */
 
@@ -15,8 +16,14 @@
 /* 3D imports */
 
 #include "3d/vector.hpp"
+#include "3d/expression.hpp"
 #include "3d/transform.hpp"
+#include "3d/affine.hpp"
+#include "3d/quaternion.hpp"
 #include "3d/shapes.hpp"
+#include "3d/clip.hpp"
+#include "3d/batch.hpp"
+#include "3d/bounds.hpp"
 
 namespace engine {
     using namespace space2D;
@@ -0,0 +1,74 @@
+#ifndef CPP_ENGINE_GLM_INTEROP_HPP
+#define CPP_ENGINE_GLM_INTEROP_HPP
+
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#include "2d/transform.hpp"
+#include "3d/transform.hpp"
+
+namespace engine {
+
+/* glm and GL order, float and column-major, the same bytes as glm::mat4 and glm::mat3 */
+using GL_Mat4 = space3D::Basic_Mat4<float, Column_Major>;
+using GL_Mat3 = space2D::Basic_Mat3<float, Column_Major>;
+
+static_assert(sizeof(GL_Mat4::mat4_t) == sizeof(glm::mat4));
+static_assert(sizeof(GL_Mat3::mat3_t) == sizeof(glm::mat3));
+
+/* Matching layouts copy straight through */
+inline auto to_glm(GL_Mat4 const& m) -> glm::mat4 {
+    auto out = glm::mat4{};
+    std::memcpy(&out, std::data(m.container), sizeof(out));
+    return out;
+}
+
+inline auto to_glm(GL_Mat3 const& m) -> glm::mat3 {
+    auto out = glm::mat3{};
+    std::memcpy(&out, std::data(m.container), sizeof(out));
+    return out;
+}
+
+inline auto from_glm(glm::mat4 const& m) -> GL_Mat4 {
+    auto out = GL_Mat4{};
+    std::memcpy(std::data(out.container), &m, sizeof(m));
+    return out;
+}
+
+inline auto from_glm(glm::mat3 const& m) -> GL_Mat3 {
+    auto out = GL_Mat3{};
+    std::memcpy(std::data(out.container), &m, sizeof(m));
+    return out;
+}
+
+/* Any other scalar or layout goes element by element, glm indexes [column][row] */
+template <class S, class L>
+auto to_glm(space3D::Basic_Mat4<S, L> const& m) -> glm::mat4 {
+    auto out = glm::mat4{};
+
+    for (auto i = 0u; i < 4; ++i) {
+        for (auto j = 0u; j < 4; ++j) {
+            out[j][i] = float(m.at(i, j));
+        }
+    }
+
+    return out;
+}
+
+template <class S, class L>
+auto to_glm(space2D::Basic_Mat3<S, L> const& m) -> glm::mat3 {
+    auto out = glm::mat3{};
+
+    for (auto i = 0u; i < 3; ++i) {
+        for (auto j = 0u; j < 3; ++j) {
+            out[j][i] = float(m.at(i, j));
+        }
+    }
+
+    return out;
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_GLM_INTEROP_HPP
@@ -1,8 +1,14 @@
 #ifndef CPP_ENGINE_TRANSFORM_BASE_HPP
 #define CPP_ENGINE_TRANSFORM_BASE_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
 #include <ranges>
+#include <type_traits>
+#include <utility>
 
 namespace engine {
 
@@ -11,10 +17,104 @@ concept Matrix = std::ranges::range<T> && requires(T t) {
     { t[std::size_t{}] } -> std::ranges::range;
 };
 
+/* Storage order of the matrix types, indexing with [i][j] always follows the storage */
+struct Row_Major {};    /* container[row][column], the engine default */
+struct Column_Major {}; /* container[column][row], the glm and GL order */
+
+template <class L>
+concept Matrix_Layout = std::same_as<L, Row_Major> || std::same_as<L, Column_Major>;
+
+} // namespace engine
+
+namespace engine::details {
+
+template <class S, std::size_t N>
+using Square = std::array<std::array<S, N>, N>;
+
+/* A whole row (or column) lines up with one vector register where it fits one */
+template <class S, std::size_t N>
+inline constexpr auto matrix_alignment = std::min(std::bit_ceil(N * sizeof(S)), std::size_t{ 32 });
+
+/* Row i of the product is the rows of right weighted by row i of left, unrolled over both k and j */
+template <class Row, class Left, class Right, std::size_t... K>
+constexpr auto broadcast_row(Left const& left_row, Right const& right, std::index_sequence<K...> k) -> Row {
+    auto column = [&](std::size_t j) {
+        return (... + (left_row[K] * right[K][j]));
+    };
+
+    return [&]<std::size_t... J>(std::index_sequence<J...>) {
+        return Row{ column(J)... };
+    }(k);
+}
+
+/* Storage product, a row-major left * right. Column-major storage is the transpose, swap the operands */
+template <class S, std::size_t N>
+constexpr auto multiply_storage(Square<S, N> const& left, Square<S, N> const& right) -> Square<S, N> {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Square<S, N>{ broadcast_row<std::array<S, N>>(left[I], right, std::make_index_sequence<N>{})... };
+    }(std::make_index_sequence<N>{});
+}
+
+/* Rows known at compile time, from std::array-like rows */
+template <class T>
+concept Fixed_Square = requires {
+    std::tuple_size<std::remove_cvref_t<decltype(std::declval<T const&>()[0])>>::value;
+};
+
+template <class T>
+inline constexpr auto fixed_extent = std::tuple_size_v<std::remove_cvref_t<decltype(std::declval<T const&>()[0])>>;
+
+template <class S, std::size_t N>
+constexpr auto transpose_storage(Square<S, N> const& m) -> Square<S, N> {
+    auto out = Square<S, N>{};
+
+    for (auto i = 0u; i < N; ++i) {
+        for (auto j = 0u; j < N; ++j) {
+            out[j][i] = m[i][j];
+        }
+    }
+
+    return out;
+}
+
+/* Rows written in math order, laid out for Layout */
+template <class S, std::size_t N, class Layout>
+constexpr auto from_rows(Square<double, N> const& rows) -> Square<S, N> {
+    auto out = Square<S, N>{};
+
+    for (auto i = 0u; i < N; ++i) {
+        for (auto j = 0u; j < N; ++j) {
+            if constexpr (std::same_as<Layout, Row_Major>) {
+                out[i][j] = S(rows[i][j]);
+            } else {
+                out[j][i] = S(rows[i][j]);
+            }
+        }
+    }
+
+    return out;
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+/* 3x3 and 4x4 of known size go through the unrolled product, anything else loops */
 template <Matrix T>
-auto operator*(T const& left, T const& right) -> T {
+constexpr auto operator*(T const& left, T const& right) -> T {
     auto product = T{};
 
+    if constexpr (details::Fixed_Square<T>) {
+        if constexpr (details::fixed_extent<T> == 3 || details::fixed_extent<T> == 4) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((product[I] = details::broadcast_row<std::remove_cvref_t<decltype(product[I])>>(
+                    left[I], right, std::make_index_sequence<details::fixed_extent<T>>{})), ...);
+            }(std::make_index_sequence<details::fixed_extent<T>>{});
+
+            return product;
+        }
+    }
+
     for (auto i = 0u; i < std::size(product); ++i) {
         for (auto j = 0u; j < std::size(product); ++j) {
             for (auto k = 0u; k < std::size(product); ++k) {
@@ -26,6 +126,6 @@ auto operator*(T const& left, T const& right) -> T {
     return product;
 }
 
-}
+} // namespace engine
 
 #endif //CPP_ENGINE_TRANSFORM_BASE_HPP
@@ -0,0 +1,250 @@
+#ifndef CPP_ENGINE_TRIG_HPP
+#define CPP_ENGINE_TRIG_HPP
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../utility/cpu.hpp"
+
+namespace engine {
+
+template <std::floating_point T>
+struct Sin_Cos {
+    T sin;
+    T cos;
+};
+
+/**
+ * exact goes to std::sin and std::cos.
+ * full is a polynomial a few ulp from T while the reduction is exact, and constexpr.
+ * fast stops at float accuracy (about 3e-7), enough for vertex positions.
+ * Both reduce by pi / 2 exactly up to 2^20 quadrants for double and 2^12 for float (about 1.6e6 and 6.4e3
+ * radians), beyond that and for inf or nan they go to std::sin and std::cos.
+ * */
+enum class Trig_Precision {
+    exact,
+    full,
+    fast
+};
+
+/* Angle in degrees, rotations taking one look whole and half degrees up in a table */
+struct Degrees {
+    double value;
+};
+
+constexpr auto operator-(Degrees angle) -> Degrees {
+    return { -angle.value };
+}
+
+} // namespace engine
+
+namespace engine::details {
+
+/* pi / 2 split so k * pi_2_high is exact for |k| < 2^20, then the rest (Cody-Waite) */
+inline constexpr auto pi_2_high = 1.57079632673412561417e+00;
+inline constexpr auto pi_2_low = 6.07710050650619224932e-11;
+
+/* Float split, three parts, each product exact for |k| < 2^12 */
+inline constexpr auto pi_2_high_f = 1.5703125f;
+inline constexpr auto pi_2_mid_f = 4.837512969970703125e-4f;
+inline constexpr auto pi_2_low_f = 7.54978995489188216e-8f;
+
+/* Quadrants the splits above reduce exactly */
+template <class T>
+inline constexpr auto reduce_limit = std::same_as<T, float> ? T(1 << 12) : T(1 << 20);
+
+/* False past the exact reduction and for inf or nan, which compare false */
+template <class T>
+constexpr auto reducible(T angle) -> bool {
+    auto t = angle * T(2 / std::numbers::pi);
+    return t < reduce_limit<T> && t > -reduce_limit<T>;
+}
+
+/* Taylor terms on [-pi/4, pi/4], sin as x + x^3 (s0 + x^2 (s1 + ...)), cos as 1 - x^2 / 2 + x^4 (c0 + ...) */
+inline constexpr auto sin_terms = std::array{
+    -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880, -1.0 / 39916800, 1.0 / 6227020800, -1.0 / 1307674368000
+};
+inline constexpr auto cos_terms = std::array{
+    1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800, 1.0 / 479001600, -1.0 / 87178291200, 1.0 / 20922789888000
+};
+
+/* Terms kept per precision, the remainder is below the target on [-pi/4, pi/4] */
+template <Trig_Precision P>
+inline constexpr auto trig_terms = P == Trig_Precision::fast ? std::size_t{ 3 } : std::size_t{ 7 };
+
+template <std::size_t N, class T>
+constexpr auto horner(std::array<double, 7> const& terms, T x2) -> T {
+    auto sum = T(terms[N - 1]);
+
+    for (auto i = N - 1; i-- > 0;) {
+        sum = sum * x2 + T(terms[i]);
+    }
+
+    return sum;
+}
+
+/* Reduced angle r in [-pi/4, pi/4] and quadrant k, angle = k pi / 2 + r, for reducible angles only */
+template <class T>
+constexpr auto reduce(T angle) -> std::pair<T, long long> {
+    auto t = angle * T(2 / std::numbers::pi);
+    auto k = static_cast<long long>(t + (t < 0 ? T(-0.5) : T(0.5)));
+    auto kt = T(k);
+
+    if constexpr (std::same_as<T, float>) {
+        return { ((angle - kt * pi_2_high_f) - kt * pi_2_mid_f) - kt * pi_2_low_f, k };
+    } else {
+        return { T((angle - kt * T(pi_2_high)) - kt * T(pi_2_low)), k };
+    }
+}
+
+template <Trig_Precision P, class T>
+constexpr auto sincos_polynomial(T angle) -> Sin_Cos<T> {
+    auto [ r, k ] = reduce(angle);
+    auto r2 = r * r;
+
+    auto s = r + r * r2 * horner<trig_terms<P>>(sin_terms, r2);
+    auto c = T(1) - r2 / 2 + r2 * r2 * horner<trig_terms<P>>(cos_terms, r2);
+
+    switch (k & 3) {
+        case 0:  return { s, c };
+        case 1:  return { c, -s };
+        case 2:  return { -s, -c };
+        default: return { -c, s };
+    }
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+/* Both values of one angle in radians, at the precision asked for */
+template <Trig_Precision P = Trig_Precision::full, std::floating_point T>
+constexpr auto sincos(T angle) -> Sin_Cos<T> {
+    if constexpr (P == Trig_Precision::exact) {
+        if (!std::is_constant_evaluated()) {
+            return { std::sin(angle), std::cos(angle) };
+        }
+        return details::sincos_polynomial<Trig_Precision::full>(angle);
+    } else {
+        if (!std::is_constant_evaluated() && !details::reducible(angle)) {
+            return { std::sin(angle), std::cos(angle) };
+        }
+        return details::sincos_polynomial<P>(angle);
+    }
+}
+
+} // namespace engine
+
+namespace engine::details {
+
+/* Every half degree of the circle, built at compile time */
+inline constexpr auto half_degree_steps = std::size_t{ 720 };
+
+inline constexpr auto half_degree_table = [] {
+    auto table = std::array<Sin_Cos<double>, half_degree_steps>{};
+
+    for (auto i = 0u; i < half_degree_steps; ++i) {
+        table[i] = sincos<Trig_Precision::full>(double(i) * (std::numbers::pi / 360));
+    }
+
+    return table;
+}();
+
+#if defined(CPP_ENGINE_X86)
+
+/* Eight angles at a time, the same reduction and polynomial as the scalar path */
+template <Trig_Precision P>
+CPP_ENGINE_TARGET_AVX2
+inline auto sincos_avx2(float const * angle, float * sin, float * cos) -> void {
+    auto x = _mm256_loadu_ps(angle);
+    auto t = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(float(2 / std::numbers::pi))),
+                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    auto r = _mm256_sub_ps(x, _mm256_mul_ps(t, _mm256_set1_ps(pi_2_high_f)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(t, _mm256_set1_ps(pi_2_mid_f)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(t, _mm256_set1_ps(pi_2_low_f)));
+
+    auto r2 = _mm256_mul_ps(r, r);
+
+    auto polynomial = [&r2](std::size_t degree, std::array<double, 7> const& terms) CPP_ENGINE_TARGET_AVX2 {
+        auto sum = _mm256_set1_ps(float(terms[degree - 1]));
+        for (auto i = degree - 1; i-- > 0;) {
+            sum = _mm256_add_ps(_mm256_mul_ps(sum, r2), _mm256_set1_ps(float(terms[i])));
+        }
+        return sum;
+    };
+
+    auto s = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), polynomial(trig_terms<P>, sin_terms)));
+    auto c = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))),
+                           _mm256_mul_ps(_mm256_mul_ps(r2, r2), polynomial(trig_terms<P>, cos_terms)));
+
+    /* odd quadrants swap sin and cos, quadrants 2 and 3 negate sin, 1 and 2 negate cos */
+    auto k = _mm256_cvtps_epi32(t);
+    auto swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(k, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+    auto sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(k, _mm256_set1_epi32(2)), 30));
+    auto cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(k, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+    _mm256_storeu_ps(sin, _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sin_sign));
+    _mm256_storeu_ps(cos, _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cos_sign));
+
+    /* lanes past the exact reduction, or inf and nan (unordered), are redone with libm */
+    auto quadrants = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), t);
+    auto outside = _mm256_movemask_ps(_mm256_cmp_ps(quadrants, _mm256_set1_ps(reduce_limit<float>), _CMP_NLT_UQ));
+
+    for (auto lane = 0; outside != 0; ++lane, outside >>= 1) {
+        if (outside & 1) {
+            sin[lane] = std::sin(angle[lane]);
+            cos[lane] = std::cos(angle[lane]);
+        }
+    }
+}
+
+#endif
+
+} // namespace engine::details
+
+namespace engine {
+
+/* Half degree steps come from the table, anything else is computed */
+inline auto sincos(Degrees degrees) -> Sin_Cos<double> {
+    auto steps = degrees.value * 2;
+
+    if (auto whole = std::nearbyint(steps); whole == steps && std::abs(whole) < 1e15) {
+        auto index = static_cast<long long>(whole) % static_cast<long long>(details::half_degree_steps);
+        return details::half_degree_table[std::size_t(index < 0 ? index + details::half_degree_steps : index)];
+    }
+
+    return sincos(degrees.value * (std::numbers::pi / 180));
+}
+
+/* Many angles at once, float runs eight lanes wide on AVX2 */
+template <Trig_Precision P = Trig_Precision::full, std::floating_point T>
+auto sincos(std::span<T const> angle, std::span<T> sin, std::span<T> cos) -> void {
+    auto i = std::size_t{};
+
+#if defined(CPP_ENGINE_X86)
+    if constexpr (std::same_as<T, float> && P != Trig_Precision::exact) {
+        if (cpu::features().avx2) {
+            for (; i + 8 <= std::size(angle); i += 8) {
+                details::sincos_avx2<P>(std::data(angle) + i, std::data(sin) + i, std::data(cos) + i);
+            }
+        }
+    }
+#endif
+
+    for (; i < std::size(angle); ++i) {
+        auto [ s, c ] = sincos<P>(angle[i]);
+        sin[i] = s;
+        cos[i] = c;
+    }
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_TRIG_HPP
@@ -0,0 +1,95 @@
+#include <charconv>
+#include <cstdlib>
+#include <execution>
+#include <string_view>
+
+#include <fmt/core.h>
+
+#include "io/obj_reader.hpp"
+#include "offline/renderer.hpp"
+
+namespace {
+
+auto usage() -> int {
+    fmt::print("usage: headless <model.obj> [--frames N] [--size WxH] [--mode wire|tiled|filled|solid|textured]\n"
+               "                [--texture IMAGE] [--out DIR] [--format png|raw] [--scale S] [--tilt DEGREES]\n");
+    return EXIT_FAILURE;
+}
+
+template <class T>
+auto parse_number(std::string_view text, T & value) -> bool {
+    auto [ end, error ] = std::from_chars(std::data(text), std::data(text) + std::size(text), value);
+    return error == std::errc{} && end == std::data(text) + std::size(text);
+}
+
+} // namespace
+
+auto main(int argc, char ** argv) -> int {
+    if (argc < 2) {
+        return usage();
+    }
+
+    auto options = engine::offline::Render_Options{};
+    auto scale = 1.0, tilt = 0.0;
+
+    for (auto i = 2; i < argc; ++i) {
+        auto flag = std::string_view{ argv[i] };
+
+        if (i + 1 >= argc) {
+            return usage();
+        }
+
+        auto value = std::string_view{ argv[++i] };
+        auto ok = true;
+
+        if (flag == "--frames") {
+            ok = parse_number(value, options.frames);
+        } else if (flag == "--size") {
+            auto x = value.find('x');
+            ok = x != std::string_view::npos
+                && parse_number(value.substr(0, x), options.width)
+                && parse_number(value.substr(x + 1), options.height)
+                && options.width > 0 && options.height > 0;
+        } else if (flag == "--mode") {
+            if (value == "wire") options.mode = engine::offline::Draw_Mode::wire;
+            else if (value == "tiled") options.mode = engine::offline::Draw_Mode::tiled;
+            else if (value == "filled") options.mode = engine::offline::Draw_Mode::filled;
+            else if (value == "solid") options.mode = engine::offline::Draw_Mode::solid;
+            else if (value == "textured") options.mode = engine::offline::Draw_Mode::textured;
+            else ok = false;
+        } else if (flag == "--texture") {
+            options.texture = value;
+        } else if (flag == "--out") {
+            options.output = value;
+        } else if (flag == "--format") {
+            if (value == "png") options.format = engine::offline::Image_Format::png;
+            else if (value == "raw") options.format = engine::offline::Image_Format::raw;
+            else ok = false;
+        } else if (flag == "--scale") {
+            ok = parse_number(value, scale);
+        } else if (flag == "--tilt") {
+            ok = parse_number(value, tilt);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print("Err(bad argument {} {})\n", flag, value);
+            return usage();
+        }
+    }
+
+    auto solid = engine::io::read_wavefront(std::execution::par, argv[1]);
+
+    if (std::empty(solid.vertex())) {
+        fmt::print("Err(could not load {})\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    fmt::print("Vertex {} Faces {} Edges {}\n", std::size(solid.vertex()), std::size(solid.faces()), std::size(solid.edges));
+
+    auto report = engine::offline::render(solid, engine::offline::Camera_Path::orbit(scale, tilt), options);
+    report.print();
+
+    return report.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
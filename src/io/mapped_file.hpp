@@ -0,0 +1,147 @@
+#ifndef CPP_ENGINE_MAPPED_FILE_HPP
+#define CPP_ENGINE_MAPPED_FILE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace engine::io {
+
+/**
+ * Read only view of a whole file through the page cache, nothing is copied into the process.
+ * Empty when the file cannot be opened or mapped, or has no bytes.
+ * */
+class Mapped_File {
+    char const* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_released = 0;
+
+public:
+    Mapped_File() = default;
+
+    explicit Mapped_File(std::filesystem::path const& path) {
+#if defined(_WIN32)
+        auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        auto size = LARGE_INTEGER{};
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            if (auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                if (auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                    m_data = static_cast<char const*>(view);
+                    m_size = static_cast<std::size_t>(size.QuadPart);
+                }
+                CloseHandle(mapping); /* the view keeps the mapping alive */
+            }
+        }
+
+        CloseHandle(file);
+#else
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info = {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            auto size = static_cast<std::size_t>(info.st_size);
+
+            if (auto view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); view != MAP_FAILED) {
+                ::madvise(view, size, MADV_SEQUENTIAL);
+                m_data = static_cast<char const*>(view);
+                m_size = size;
+            }
+        }
+
+        ::close(fd); /* the mapping outlives the descriptor */
+#endif
+    }
+
+    Mapped_File(Mapped_File const&) = delete;
+    auto operator=(Mapped_File const&) -> Mapped_File& = delete;
+
+    Mapped_File(Mapped_File && other) noexcept :
+     m_data(std::exchange(other.m_data, nullptr)),
+     m_size(std::exchange(other.m_size, 0)),
+     m_released(std::exchange(other.m_released, 0))
+    {}
+
+    auto operator=(Mapped_File && other) noexcept -> Mapped_File& {
+        if (this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_released = std::exchange(other.m_released, 0);
+        }
+        return *this;
+    }
+
+    ~Mapped_File() {
+        unmap();
+    }
+
+    [[nodiscard]] auto view() const -> std::string_view {
+        return { m_data, m_size };
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return m_size;
+    }
+
+    explicit operator bool() const {
+        return m_data != nullptr;
+    }
+
+    /**
+     * Drops the whole pages before end from the resident set, for a reader that never looks back. The view stays
+     * valid, a page read again comes back from the file.
+     * */
+    auto release(std::size_t end) -> void {
+#if !defined(_WIN32)
+        auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto last = std::min(end, m_size) / page * page;
+
+        if (m_data && last > m_released) {
+            ::madvise(const_cast<char *>(m_data) + m_released, last - m_released, MADV_DONTNEED);
+            m_released = last;
+        }
+#else
+        static_cast<void>(end); /* views of read only files are trimmed by the system under pressure */
+#endif
+    }
+
+private:
+    auto unmap() -> void {
+        if (m_data) {
+#if defined(_WIN32)
+            UnmapViewOfFile(m_data);
+#else
+            ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+            m_data = nullptr;
+            m_size = 0;
+            m_released = 0;
+        }
+    }
+};
+
+} // namespace engine::io
+
+#endif //CPP_ENGINE_MAPPED_FILE_HPP
@@ -0,0 +1,324 @@
+#ifndef CPP_ENGINE_MESH_CACHE_HPP
+#define CPP_ENGINE_MESH_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "../geometry/core.hpp"
+#include "./mapped_file.hpp"
+#include "./obj_reader.hpp"
+#include "./weld.hpp"
+
+/**
+ * Binary mesh cache, a header then the interleaved float vertices and the triangle indexes, each block 16 byte
+ * aligned. A vertex is x y z, then u v and nx ny nz when the attributes say so. Indexes are uint16 while every
+ * vertex fits, uint32 beyond. Everything is in the writer's byte order, a reader
+ * with the other order sees a wrong ident and rebuilds. The source size and write time go in the header so an
+ * edited OBJ is converted again.
+ * */
+
+namespace engine::io {
+
+constexpr auto MESH_IDENT = std::uint32_t(('H' << 24) + ('M' << 16) + ('E' << 8) + 'C');
+constexpr auto MESH_VERSION = std::uint32_t(2);
+
+struct Mesh_Header {
+    std::uint32_t ident;
+    std::uint32_t version;
+    std::uint32_t index_size;
+    std::uint32_t vertex_count;
+    std::uint32_t vertex_stride;
+    std::uint32_t attributes;
+    std::uint64_t index_count;
+    std::uint64_t ofs_vertex;
+    std::uint64_t ofs_indexes;
+    std::uint64_t ofs_end;
+    std::uint64_t source_size;
+    std::int64_t source_time;
+    Aabb<float> box;
+    Bounding_Sphere<float> sphere;
+};
+
+static_assert(std::is_trivially_copyable_v<Mesh_Header>);
+
+} // namespace engine::io
+
+namespace engine::io::details {
+
+inline constexpr auto mesh_alignment = std::uint64_t{ 16 };
+
+inline auto align_mesh_block(std::uint64_t offset) -> std::uint64_t {
+    return (offset + mesh_alignment - 1) & ~(mesh_alignment - 1);
+}
+
+/* Size and write time of the source, both zero when it cannot be read */
+inline auto source_stamp(std::filesystem::path const& source) -> std::pair<std::uint64_t, std::int64_t> {
+    auto error = std::error_code{};
+    auto size = std::filesystem::file_size(source, error);
+    if (error) {
+        return {};
+    }
+
+    auto time = std::filesystem::last_write_time(source, error);
+    if (error) {
+        return {};
+    }
+
+    return { size, static_cast<std::int64_t>(time.time_since_epoch().count()) };
+}
+
+/* Faces as fans 0-1-2 0-2-3 ..., zero based */
+template <class Index>
+auto triangulate(Solid<float> const& solid) -> std::vector<Index> {
+    auto indexes = std::vector<Index>{};
+
+    for (auto const& face : solid.faces()) {
+        auto const& corner = face.indexes;
+
+        for (auto i = 2ul; i < std::size(corner); ++i) {
+            indexes.push_back(static_cast<Index>(corner[0] - 1));
+            indexes.push_back(static_cast<Index>(corner[i - 1] - 1));
+            indexes.push_back(static_cast<Index>(corner[i] - 1));
+        }
+    }
+
+    return indexes;
+}
+
+} // namespace engine::io::details
+
+namespace engine::io {
+
+/**
+ * Triangulated mesh ready for glBufferData. The bytes either live in the mesh, when it was built from a Solid, or
+ * stay in a mapped cache file and go to the driver from the page cache.
+ * */
+class Mesh {
+    Mesh_Header m_header = {};
+    Mapped_File m_file;
+    std::vector<std::byte> m_bytes;
+
+public:
+    Mesh() = default;
+
+    /* Solids with texture coordinates or normals are welded into interleaved vertices, others keep their positions */
+    static auto from_solid(Solid<float> const& solid) -> Mesh {
+        auto volumes = solid.bounding_volumes();
+
+        if (!std::empty(solid.uv) || !std::empty(solid.normal)) {
+            if (auto welded = weld(solid); welded.attributes != 0) {
+                if (welded.vertex_count() > std::size_t{ 1 } << 16) {
+                    return build(volumes, welded.vertex, welded.attributes, welded.indexes);
+                }
+
+                auto narrow = std::vector<std::uint16_t>(std::begin(welded.indexes), std::end(welded.indexes));
+                return build(volumes, welded.vertex, welded.attributes, narrow);
+            }
+        }
+
+        auto positions = std::span{ reinterpret_cast<float const*>(std::data(solid.vertex())), 3 * std::size(solid.vertex()) };
+
+        if (std::size(solid.vertex()) > std::size_t{ 1 } << 16) {
+            return build(volumes, positions, 0, details::triangulate<std::uint32_t>(solid));
+        }
+
+        return build(volumes, positions, 0, details::triangulate<std::uint16_t>(solid));
+    }
+
+    /* Maps a cache file, empty when it is missing, of another version or truncated */
+    static auto map(std::filesystem::path const& path) -> std::optional<Mesh> {
+        auto file = Mapped_File{ path };
+
+        if (!file || file.size() < sizeof(Mesh_Header)) {
+            return {};
+        }
+
+        auto header = Mesh_Header{};
+        std::memcpy(&header, std::data(file.view()), sizeof(Mesh_Header));
+
+        auto vertex_end = header.ofs_vertex + std::uint64_t{ header.vertex_stride } * header.vertex_count;
+        auto valid = header.ident == MESH_IDENT && header.version == MESH_VERSION
+                  && header.attributes <= (vertex_texture | vertex_normal)
+                  && header.vertex_stride == sizeof(float) * vertex_floats(header.attributes)
+                  && (header.index_size == 2 || header.index_size == 4)
+                  && header.ofs_vertex % details::mesh_alignment == 0 && header.ofs_indexes % details::mesh_alignment == 0
+                  && header.ofs_vertex >= sizeof(Mesh_Header) && vertex_end <= header.ofs_indexes
+                  && header.ofs_indexes + header.index_size * header.index_count == header.ofs_end
+                  && header.ofs_end <= file.size();
+
+        if (!valid) {
+            return {};
+        }
+
+        auto mesh = Mesh{};
+        mesh.m_header = header;
+        mesh.m_file = std::move(file);
+
+        return mesh;
+    }
+
+    /* Header then blocks, written beside path and renamed so a reader never maps half a file */
+    auto write(std::filesystem::path const& path) const -> bool {
+        auto header = m_header;
+        auto bytes = data();
+        auto temporary = std::filesystem::path{ path }.concat(".tmp");
+
+        {
+            auto file = std::ofstream(temporary, std::ofstream::binary | std::ofstream::trunc);
+            auto padding = std::vector<char>(header.ofs_vertex - sizeof(Mesh_Header));
+
+            file.write(reinterpret_cast<char const*>(&header), sizeof(Mesh_Header));
+            file.write(std::data(padding), static_cast<std::streamsize>(std::size(padding)));
+            file.write(reinterpret_cast<char const*>(std::data(bytes)) + header.ofs_vertex,
+                       static_cast<std::streamsize>(header.ofs_end - header.ofs_vertex));
+
+            if (!file) {
+                return false;
+            }
+        }
+
+        auto error = std::error_code{};
+        std::filesystem::rename(temporary, path, error);
+
+        return !error;
+    }
+
+    auto stamp(std::filesystem::path const& source) -> void {
+        std::tie(m_header.source_size, m_header.source_time) = details::source_stamp(source);
+    }
+
+    [[nodiscard]] auto header() const -> Mesh_Header const& {
+        return m_header;
+    }
+
+    [[nodiscard]] auto vertex_data() const -> std::span<std::byte const> {
+        return data().subspan(m_header.ofs_vertex, std::size_t{ m_header.vertex_stride } * m_header.vertex_count);
+    }
+
+    [[nodiscard]] auto index_data() const -> std::span<std::byte const> {
+        return data().subspan(m_header.ofs_indexes, m_header.index_size * m_header.index_count);
+    }
+
+    [[nodiscard]] auto index_count() const -> std::size_t {
+        return m_header.index_count;
+    }
+
+    [[nodiscard]] auto index_size() const -> std::size_t {
+        return m_header.index_size;
+    }
+
+    [[nodiscard]] auto vertex_count() const -> std::size_t {
+        return m_header.vertex_count;
+    }
+
+    /* Bytes from one vertex to the next */
+    [[nodiscard]] auto vertex_stride() const -> std::size_t {
+        return m_header.vertex_stride;
+    }
+
+    /* vertex_texture and vertex_normal bits */
+    [[nodiscard]] auto attributes() const -> std::uint32_t {
+        return m_header.attributes;
+    }
+
+    [[nodiscard]] auto empty() const -> bool {
+        return m_header.ident != MESH_IDENT;
+    }
+
+private:
+    /* Same layout as the file, writing it is a single block */
+    template <class Index>
+    static auto build(Bounds<float> const& volumes, std::span<float const> vertex, std::uint32_t attributes,
+                      std::vector<Index> const& indexes) -> Mesh {
+        auto mesh = Mesh{};
+        auto& header = mesh.m_header;
+        auto vertex_bytes = sizeof(float) * std::size(vertex);
+        auto index_bytes = sizeof(Index) * std::size(indexes);
+
+        header.ident = MESH_IDENT;
+        header.version = MESH_VERSION;
+        header.index_size = sizeof(Index);
+        header.vertex_count = static_cast<std::uint32_t>(std::size(vertex) / vertex_floats(attributes));
+        header.vertex_stride = static_cast<std::uint32_t>(sizeof(float) * vertex_floats(attributes));
+        header.attributes = attributes;
+        header.index_count = std::size(indexes);
+        header.ofs_vertex = details::align_mesh_block(sizeof(Mesh_Header));
+        header.ofs_indexes = details::align_mesh_block(header.ofs_vertex + vertex_bytes);
+        header.ofs_end = header.ofs_indexes + index_bytes;
+        header.box = volumes.box;
+        header.sphere = volumes.sphere;
+
+        mesh.m_bytes.resize(header.ofs_end);
+        std::memcpy(std::data(mesh.m_bytes) + header.ofs_vertex, std::data(vertex), vertex_bytes);
+        std::memcpy(std::data(mesh.m_bytes) + header.ofs_indexes, std::data(indexes), index_bytes);
+
+        return mesh;
+    }
+
+    [[nodiscard]] auto data() const -> std::span<std::byte const> {
+        if (m_file) {
+            auto view = m_file.view();
+            return { reinterpret_cast<std::byte const*>(std::data(view)), std::size(view) };
+        }
+
+        return m_bytes;
+    }
+};
+
+/* The cache beside an OBJ, model.obj gives model.obj.mesh */
+inline auto mesh_cache_path(std::filesystem::path const& source) -> std::filesystem::path {
+    return std::filesystem::path{ source }.concat(".mesh");
+}
+
+/* Reads and triangulates an OBJ, stamped with its size and write time */
+inline auto convert_wavefront(std::filesystem::path const& source) -> Mesh {
+    auto mesh = Mesh::from_solid(read_wavefront<float>(std::execution::par, source));
+    mesh.stamp(source);
+
+    return mesh;
+}
+
+/**
+ * The mapped cache when it matches the source, otherwise the OBJ is parsed and the cache written for next time.
+ * A cache without its source is still used, so shipped caches work on their own.
+ * */
+inline auto load_mesh(std::filesystem::path const& source, std::filesystem::path const& cache) -> Mesh {
+    auto stamp = details::source_stamp(source);
+
+    if (auto mapped = Mesh::map(cache)) {
+        auto const& header = mapped->header();
+
+        if (stamp == std::pair{ std::uint64_t{}, std::int64_t{} }
+                || (header.source_size == stamp.first && header.source_time == stamp.second)) {
+            return std::move(*mapped);
+        }
+    }
+
+    auto mesh = convert_wavefront(source);
+
+    if (!mesh.empty() && mesh.vertex_count() > 0 && !mesh.write(cache)) {
+        fmt::print("Err(could not write mesh cache {})\n", cache.string());
+    }
+
+    return mesh;
+}
+
+inline auto load_mesh(std::filesystem::path const& source) -> Mesh {
+    return load_mesh(source, mesh_cache_path(source));
+}
+
+} // namespace engine::io
+
+#endif //CPP_ENGINE_MESH_CACHE_HPP
@@ -0,0 +1,84 @@
+#ifndef CPP_ENGINE_MESH_STREAM_HPP
+#define CPP_ENGINE_MESH_STREAM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "../utility/bounded_queue.hpp"
+#include "./obj_reader.hpp"
+#include "./weld.hpp"
+
+namespace engine::io {
+
+/**
+ * Reads and welds an OBJ on a background thread, one Interleaved_Mesh per batch for the GPU to append.
+ * At most depth batches wait in memory, the reader blocks beyond that, so a slow consumer bounds the peak.
+ * The welder's own state is on top of that, see Stream_Welder: nothing for positions only, the whole attribute
+ * set once the file has vt or vn.
+ * */
+class Mesh_Stream {
+    util::Bounded_Queue<Interleaved_Mesh> m_batches;
+    std::atomic<bool> m_finished;
+
+    std::thread m_worker;
+
+public:
+    explicit Mesh_Stream(std::filesystem::path path, std::size_t depth = 4,
+                         std::size_t batch_bytes = details::obj_chunk_size) :
+        m_batches(depth),
+        m_finished(false),
+        m_worker([this, path = std::move(path), batch_bytes] { work(path, batch_bytes); })
+    {}
+
+    Mesh_Stream(Mesh_Stream const&) = delete;
+    auto operator=(Mesh_Stream const&) -> Mesh_Stream & = delete;
+
+    /* Stops the reader at its next batch */
+    ~Mesh_Stream() {
+        m_batches.close();
+
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+    /* Next batch if one is ready, never blocks */
+    auto try_pop() -> std::optional<Interleaved_Mesh> {
+        return m_batches.try_pop();
+    }
+
+    /* Blocks for the next batch, nullopt once the whole file went through */
+    auto pop() -> std::optional<Interleaved_Mesh> {
+        return m_batches.pop();
+    }
+
+    /* The file is read and every batch taken */
+    [[nodiscard]] auto finished() const -> bool {
+        return m_finished && m_batches.size() == 0;
+    }
+
+private:
+    auto work(std::filesystem::path const& path, std::size_t batch_bytes) -> void {
+        auto welder = Stream_Welder<float>{};
+
+        auto read = stream_wavefront<float>(path, [this, &welder](Obj_Batch<float> && batch) {
+            auto mesh = welder.append(batch);
+            return std::empty(mesh.vertex) && std::empty(mesh.indexes) ? true : m_batches.push(std::move(mesh));
+        }, batch_bytes);
+
+        if (!read) {
+            fmt::print("Err(could not read {})\n", path.string());
+        }
+
+        m_finished = true;
+        m_batches.close();
+    }
+};
+
+} // namespace engine::io
+
+#endif //CPP_ENGINE_MESH_STREAM_HPP
@@ -2,9 +2,15 @@
 #define CPP_ENGINE_OBJ_READER_HPP
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 #include <fstream>
-#include <sstream>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <filesystem>
@@ -14,193 +20,411 @@
 
 #include "../geometry/core.hpp"
 #include "../utility/result.hpp"
+#include "./mapped_file.hpp"
 
 namespace engine::io::details {
 
-auto trim_view(std::string_view view) -> std::string_view {
-    view.remove_prefix(std::min(view.find_first_not_of(' '), std::size(view)));
-    view.remove_suffix(std::min(std::size(view) - view.find_last_not_of(' ') - 1, std::size(view)));
+/**
+ * Scanning backend, works on the whole text in place. Lines, numbers and indexes are read with string_view and
+ * from_chars, the only allocations are the Solid's own vectors.
+ * */
+
+inline auto is_blank(char c) -> bool {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline auto skip_blank(std::string_view view) -> std::string_view {
+    auto first = std::find_if_not(std::begin(view), std::end(view), is_blank);
+    view.remove_prefix(std::distance(std::begin(view), first));
 
     return view;
 }
 
-auto find_first_numeric(std::string_view view) {
-    return std::find_if(std::begin(view), std::end(view), [](auto c){
-        return c >= '0' && c <= '9' || c == '-';
-    });
+/* Line without its end of line, view moves past it */
+inline auto next_line(std::string_view & view) -> std::string_view {
+    auto end = view.find('\n');
+    auto line = view.substr(0, end);
+    view.remove_prefix(end == std::string_view::npos ? std::size(view) : end + 1);
+
+    return line;
 }
 
-template <class Value_Type, class Stream, class It>
-auto read_stream_n(Stream && stream, It it, std::size_t n) -> std::size_t {
-    auto count = 0ul;
-    auto buffer = Value_Type{};
+/* Number right at the front of view, view moves past it */
+template <class Value_Type>
+auto parse_number(std::string_view & view, Value_Type & value) -> bool {
+    if (!std::empty(view) && view.front() == '+') {
+        view.remove_prefix(1);
+    }
+
+    auto [ ptr, ec ] = std::from_chars(std::data(view), std::data(view) + std::size(view), value);
 
-    /* Read stream n successful times */
-    while (count < n
-            && (stream >> buffer).fail() == false) {
-        *(it++) = buffer;
-        ++count;
+    if (ec != std::errc{}) {
+        return false;
     }
 
-    return count;
+    view.remove_prefix(ptr - std::data(view));
+    return true;
 }
 
-template <class T = double>
-auto parse_vertex_data(std::string_view view, std::size_t count = 4) -> std::vector<T> {
-    if (auto index = find_first_numeric(view); index != std::end(view)) {
-        view.remove_prefix(std::distance(std::begin(view), index));
+/* Number after any blanks */
+template <class Value_Type>
+auto scan_number(std::string_view & view, Value_Type & value) -> bool {
+    view = skip_blank(view);
+    return parse_number(view, value);
+}
 
-        auto data = std::vector<T>{};
-        read_stream_n<T>(std::istringstream(std::string(view)),
-                            std::back_inserter(data), count);
+/* v x y z [w], w is dropped */
+template <class T>
+auto scan_tag_vertex(std::string_view view) -> util::Result<Vector_3D<T>, std::string_view> {
+    auto vertex = Vector_3D<T>{};
 
-        return data;
+    if (scan_number(view, vertex.x) && scan_number(view, vertex.y) && scan_number(view, vertex.z)) {
+        return { .data = vertex };
     }
 
-    return {};
+    return { .err = "Malformed vertex data", .is_err = true };
 }
 
-template <class Value_Type, class Stream, class It>
-auto parse_face_triple(Stream && stream, It it) -> std::size_t {
-    auto count = 0ul;
-    auto buffer = Value_Type{};
+/* vt u [v [w]], v is 0 when missing and w is dropped */
+template <class T>
+auto scan_tag_texture(std::string_view view) -> util::Result<space2D::Vector_2D<T>, std::string_view> {
+    auto uv = space2D::Vector_2D<T>{};
+
+    if (scan_number(view, uv.x)) {
+        scan_number(view, uv.y);
+        return { .data = uv };
+    }
+
+    return { .err = "Malformed texture data", .is_err = true };
+}
 
-    auto peek_slash = [](auto & stream) -> bool {
-        auto peek = stream.peek();
-        if (peek == '/' && stream.get()) {
-            stream.clear();
-            return true;
+/* vn x y z */
+template <class T>
+auto scan_tag_normal(std::string_view view) -> util::Result<Vector_3D<T>, std::string_view> {
+    auto normal = Vector_3D<T>{};
+
+    if (scan_number(view, normal.x) && scan_number(view, normal.y) && scan_number(view, normal.z)) {
+        return { .data = normal };
+    }
+
+    return { .err = "Malformed vertex normal data", .is_err = true };
+}
+
+/* What a face index points into */
+enum class Obj_Attribute : std::uint8_t {
+    vertex,
+    texture,
+    normal
+};
+
+/**
+ * f v v/vt v/vt/vn v//vn ..., every corner keeps its vertex, texture and normal index.
+ * A negative index counts back from the count[attribute] read so far, each such index is passed to relative.
+ * */
+template <class T, class Relative>
+auto scan_tag_face(std::string_view view, std::array<std::size_t, 3> const& count, Relative && relative)
+        -> util::Result<typename Solid<T>::Face_Indexer, std::string_view> {
+    auto face_indexer = typename Solid<T>::Face_Indexer{};
+    auto has_texture = false, has_normal = false;
+
+    auto resolve = [&count, &relative](Obj_Attribute attribute, std::size_t corner, long index) -> std::size_t {
+        if (index < 0) {
+            relative(attribute, corner);
+            return count[std::size_t(attribute)] + 1 + index;
         }
-        return false;
+        return std::size_t(index);
     };
 
-    /* Parse V index */
-    if ((stream >> buffer).fail() == false) /* [ 1 ] */ {
-        *(it++) = buffer;
-        ++count;
+    for (auto vertex = 0l; scan_number(view, vertex);) {
+        auto corner = std::size(face_indexer.indexes);
+        auto texture = 0l, normal = 0l;
 
-        if (peek_slash(stream)) /* [ 1/ ] */ {
-            /* Parse VT index */
-            if ((stream >> buffer).fail() == false) /* [ 1/1 ]  */ {
-                *(it++) = buffer;
-                ++count;
-            }
-            else /* [ 1/. ] */ {
-                stream.clear();
-                ++it;
-            }
+        if (!std::empty(view) && view.front() == '/') /* [ 1/ ] */ {
+            view.remove_prefix(1);
+            has_texture |= parse_number(view, texture); /* [ 1/1 ] */
 
-            if (peek_slash(stream)) /* [ 1/./ ] */ {
-                /* Parse VN index */
-                if ((stream >> buffer).fail() == false) /* [ 1/./1 ]  */ {
-                    *(it++) = buffer;
-                    ++count;
-                }
+            if (!std::empty(view) && view.front() == '/') /* [ 1/./ ] */ {
+                view.remove_prefix(1);
+                has_normal |= parse_number(view, normal); /* [ 1/./1 ] */
             }
         }
+
+        face_indexer.indexes.push_back(resolve(Obj_Attribute::vertex, corner, vertex));
+        face_indexer.texture.push_back(resolve(Obj_Attribute::texture, corner, texture));
+        face_indexer.normal.push_back(resolve(Obj_Attribute::normal, corner, normal));
+
+        auto corner_end = std::find_if(std::begin(view), std::end(view), is_blank);
+        view.remove_prefix(std::distance(std::begin(view), corner_end));
+    }
+
+    /* faces with positions only keep no per corner attributes */
+    if (!has_texture) {
+        face_indexer.texture.clear();
+    }
+    if (!has_normal) {
+        face_indexer.normal.clear();
     }
 
-    return count;
+    if (std::size(face_indexer.indexes) > 2) {
+        return { .data = std::move(face_indexer) };
+    }
+
+    return { .err = "Malformed face data", .is_err = true };
 }
 
-template <class T = double>
-auto parse_face_data(std::string_view view) -> typename Solid<T>::Face_Indexer {
-    if (auto index = find_first_numeric(view); index != std::end(view)) {
-        view.remove_prefix(std::distance(std::begin(view), index));
+/**
+ * What one run of whole lines holds. Negative indexes are resolved against this chunk's data only, unsigned
+ * wrap around included, so adding the counts of the chunks before it gives the file's index.
+ * */
+template <class T>
+struct Obj_Chunk {
+    struct Corner {
+        std::size_t face;
+        std::size_t corner;
+        Obj_Attribute attribute;
+    };
 
-        auto face_idx = typename Solid<T>::Face_Indexer{};
-        auto stream = std::istringstream(std::string(view));
+    struct Error {
+        std::size_t line;
+        std::string_view err;
+    };
 
-        while (stream.fail() == false && stream.eof() == false) {
-            auto data = std::array<std::size_t, 3>{};
-            auto read = parse_face_triple<int>(stream, std::begin(data));
+    std::vector<Vector_3D<T>> vertex;
+    std::vector<space2D::Vector_2D<T>> uv;
+    std::vector<Vector_3D<T>> normal;
+    std::vector<typename Solid<T>::Face_Indexer> faces;
+    std::vector<Corner> relative;
+    std::vector<Error> errors;
+    std::size_t lines = 0;
+};
 
-            if (read > 0) {
-                face_idx.indexes.push_back(data.front());
-            }
+template <class T>
+auto scan_chunk(std::string_view text) -> Obj_Chunk<T> {
+    auto chunk = Obj_Chunk<T>{};
+
+    auto keep = [&chunk](auto & into, auto && result) {
+        if (result.ok()) {
+            into.push_back(std::move(result.data));
+        } else {
+            chunk.errors.push_back({ chunk.lines, result.err });
         }
+    };
 
-        return face_idx;
-    }
+    for (; !std::empty(text); ++chunk.lines) {
+        auto view = skip_blank(next_line(text));
 
-    return {};
-}
+        if (std::size(view) > 2) { /* minimum size for comparison */
+            if (view[0] == '#') /* comment */ {}
+            else if (view[0] == 'v' && is_blank(view[1])) /* vertex */ {
+                keep(chunk.vertex, scan_tag_vertex<T>(view.substr(2)));
+            }
+            else if (view[0] == 'v' && view[1] == 't' && is_blank(view[2])) /* texture coordinate */ {
+                keep(chunk.uv, scan_tag_texture<T>(view.substr(3)));
+            }
+            else if (view[0] == 'v' && view[1] == 'n' && is_blank(view[2])) /* vertex normal */ {
+                keep(chunk.normal, scan_tag_normal<T>(view.substr(3)));
+            }
+            else if (view[0] == 'f' && is_blank(view[1])) /* face */ {
+                auto face = std::size(chunk.faces);
+                auto count = std::array{ std::size(chunk.vertex), std::size(chunk.uv), std::size(chunk.normal) };
+                auto relative = std::size(chunk.relative);
 
-template <class T = double>
-auto parse_tag_vertex(std::string_view view) -> util::Result<Vector_3D<T>, std::string_view> {
-    auto vertex = parse_vertex_data<T>(view);
+                auto result = scan_tag_face<T>(view.substr(2), count, [&chunk, face](Obj_Attribute attribute, std::size_t corner) {
+                    chunk.relative.push_back({ face, corner, attribute });
+                });
 
-    if (std::size(vertex) >= 3) {
-        return { .data = { vertex[0], vertex[1], vertex[2] } };
+                if (!result.ok()) {
+                    chunk.relative.resize(relative);
+                }
+
+                keep(chunk.faces, std::move(result));
+            }
+        }
     }
 
-    return { .err = "Malformed vertex data", .is_err = true };
+    return chunk;
 }
 
-template <class T = double>
-auto read_tag_vertex_normal(std::string_view view) {
+/* About this many bytes per parallel chunk, cut at the next end of line */
+inline constexpr auto obj_chunk_size = std::size_t{ 1 } << 20;
 
+/* Length of the first chunk of text, at least chunk_size bytes up to and with the next end of line */
+inline auto cut_lines(std::string_view text, std::size_t chunk_size) -> std::size_t {
+    auto end = text.find('\n', std::min(chunk_size, std::size(text)) - 1);
+    return end == std::string_view::npos ? std::size(text) : end + 1;
 }
 
+inline auto split_lines(std::string_view text, std::size_t chunk_size) -> std::vector<std::string_view> {
+    auto chunks = std::vector<std::string_view>{};
+
+    while (!std::empty(text)) {
+        auto length = cut_lines(text, chunk_size);
+
+        chunks.push_back(text.substr(0, length));
+        text.remove_prefix(length);
+    }
+
+    return chunks;
+}
+
+/* Negative indexes of chunk to file indexes, given how much of each kind the file held before it */
 template <class T>
-auto read_tag_face(std::string_view view) -> util::Result<typename Solid<T>::Face_Indexer, std::string_view> {
-    auto face_indexer = parse_face_data<T>(view);
+auto resolve_relative(Obj_Chunk<T> & chunk, std::size_t vertex, std::size_t uv, std::size_t normal) -> void {
+    for (auto const& [ face, corner, attribute ] : chunk.relative) {
+        auto & target = chunk.faces[face];
+
+        switch (attribute) {
+            case Obj_Attribute::vertex:  target.indexes[corner] += vertex; break;
+            case Obj_Attribute::texture: target.texture[corner] += uv;     break;
+            case Obj_Attribute::normal:  target.normal[corner] += normal;  break;
+        }
+    }
+}
 
-    if (std::size(face_indexer.indexes) > 2) {
-        return { .data = std::move(face_indexer) };
+/**
+ * Chunks in file order into one Solid. Each chunk lands at the sum of the sizes before it, in parallel under
+ * policy, so the result does not depend on how the text was cut.
+ * */
+template <class T, class Policy>
+auto stitch_chunks(Policy && policy, std::vector<Obj_Chunk<T>> & chunks) -> Solid<T> {
+    struct Offsets {
+        std::size_t vertex, uv, normal, faces, lines;
+    };
+
+    auto offsets = std::vector<Offsets>(std::size(chunks));
+    auto total = Offsets{};
+
+    for (auto i = 0ul; i < std::size(chunks); ++i) {
+        auto const& chunk = chunks[i];
+
+        offsets[i] = total;
+        total = {
+            total.vertex + std::size(chunk.vertex), total.uv + std::size(chunk.uv), total.normal + std::size(chunk.normal),
+            total.faces + std::size(chunk.faces), total.lines + chunk.lines
+        };
     }
 
-    return { .err = "Malformed face data", .is_err = true };
+    for (auto i = 0ul; i < std::size(chunks); ++i) {
+        for (auto const& [ line, err ] : chunks[i].errors) {
+            fmt::print("Err({} on LINE {})\n", err, offsets[i].lines + line);
+        }
+    }
+
+    auto solid = Solid<T>{};
+    auto vertex = std::vector<Vector_3D<T>>{};
+    auto faces = std::vector<typename Solid<T>::Face_Indexer>{};
+
+    if (std::size(chunks) == 1) {
+        vertex = std::move(chunks[0].vertex);
+        solid.uv = std::move(chunks[0].uv);
+        solid.normal = std::move(chunks[0].normal);
+        faces = std::move(chunks[0].faces);
+    } else {
+        vertex.resize(total.vertex);
+        solid.uv.resize(total.uv);
+        solid.normal.resize(total.normal);
+        faces.resize(total.faces);
+
+        auto index = std::vector<std::size_t>(std::size(chunks));
+        std::iota(std::begin(index), std::end(index), 0ul);
+
+        std::for_each(policy, std::cbegin(index), std::cend(index), [&chunks, &offsets, &solid, &vertex, &faces](std::size_t i) {
+            auto & chunk = chunks[i];
+            auto const& offset = offsets[i];
+
+            resolve_relative(chunk, offset.vertex, offset.uv, offset.normal);
+
+            std::ranges::copy(chunk.vertex, std::begin(vertex) + offset.vertex);
+            std::ranges::copy(chunk.uv, std::begin(solid.uv) + offset.uv);
+            std::ranges::copy(chunk.normal, std::begin(solid.normal) + offset.normal);
+            std::ranges::move(chunk.faces, std::begin(faces) + offset.faces);
+        });
+    }
+
+    solid.assign_vertices(std::move(vertex));
+    solid.assign_faces(std::move(faces));
+    solid.update_edges(policy);
+    solid.update_bounds();
+
+    return solid;
 }
 
 template <class T = double>
-auto parse_wv_obj(std::ifstream & input_file) -> Solid<T> {
-    // 3d model data
-    auto solid = Solid<T>{};
+auto parse_wv_obj(std::string_view text) -> Solid<T> {
+    auto chunks = std::vector<Obj_Chunk<T>>{};
+    chunks.push_back(scan_chunk<T>(text));
 
-    // context
-    auto buffer = std::string{};
-    auto count = 0ul;
+    return stitch_chunks(std::execution::seq, chunks);
+}
 
-    while (std::getline(input_file, buffer).good()) {
-        auto view = trim_view(std::string_view{buffer});
+/* Chunks parse on their own under policy, then stitch in file order, the same Solid as the serial scan */
+template <class T, class Policy>
+auto parse_wv_obj(Policy && policy, std::string_view text) -> Solid<T> {
+    auto views = split_lines(text, obj_chunk_size);
+    auto chunks = std::vector<Obj_Chunk<T>>(std::size(views));
 
-        if (std::size(view) > 2) { /* minimum size for comparison */
-            if (view[0] == '#') /* comment */ {}
-            else if (view[0] == 'v' && view[1] == ' ') /* vertex */ {
-                if (auto result = parse_tag_vertex<T>(view); result.ok()) {
-                    solid.vertex.push_back(std::move(result.data));
-                }
-                else {
-                    fmt::print("Err({} on LINE {})\n", result.err, count);
-                }
-            }
-            else if (view[0] == 'v' && view[1] == 'n') /* vertex normal */ {
+    std::transform(policy, std::cbegin(views), std::cend(views), std::begin(chunks), [](std::string_view view) {
+        return scan_chunk<T>(view);
+    });
 
-            }
-            else if (view[0] == 'f' && view[1] == ' ') /* face */ {
-                if (auto result = read_tag_face<T>(view); result.ok()) {
-                    solid.faces.push_back(std::move(result.data));
-                }
-                else {
-                    fmt::print("Err({} on LINE {})\n", result.err, count);
-                }
-            }
+    if (std::empty(chunks)) {
+        chunks.emplace_back();
+    }
+
+    return stitch_chunks(policy, chunks);
+}
+
+/**
+ * Chunks in file order one at a time. The running counts resolve negative indexes and report errors with file
+ * lines, so each chunk leaves with file indexes and nothing of the earlier ones is kept.
+ * */
+template <class T>
+class Obj_Stream {
+    std::size_t m_vertex = 0;
+    std::size_t m_uv = 0;
+    std::size_t m_normal = 0;
+    std::size_t m_lines = 0;
+
+public:
+    auto next(std::string_view text) -> Obj_Chunk<T> {
+        auto chunk = scan_chunk<T>(text);
+
+        for (auto const& [ line, err ] : chunk.errors) {
+            fmt::print("Err({} on LINE {})\n", err, m_lines + line);
         }
 
-        ++count;
+        resolve_relative(chunk, m_vertex, m_uv, m_normal);
+        chunk.relative.clear();
+        chunk.errors.clear();
+
+        m_vertex += std::size(chunk.vertex);
+        m_uv += std::size(chunk.uv);
+        m_normal += std::size(chunk.normal);
+        m_lines += chunk.lines;
+
+        return chunk;
     }
+};
 
-    return solid;
+/* Streams that cannot be mapped are read whole, then scanned the same way */
+template <class T = double>
+auto parse_wv_obj(std::ifstream & input_file) -> Solid<T> {
+    auto text = std::string(std::istreambuf_iterator<char>{ input_file }, std::istreambuf_iterator<char>{});
+    return parse_wv_obj<T>(std::string_view{ text });
 }
 
 } // namespace engine::io::details
 
 namespace engine::io {
 
+/* Maps the file and scans it in place, files that cannot be mapped are read through a stream */
 template<class D = double, class Path>
 auto read_wavefront(Path && p) -> Solid<D> {
-    auto input_file = std::ifstream{p};
+    if (auto mapped = Mapped_File{ std::filesystem::path{ p } }) {
+        return details::parse_wv_obj<D>(mapped.view());
+    }
+
+    auto input_file = std::ifstream{p, std::ifstream::binary};
 
     if (input_file) {
         return details::parse_wv_obj<D>(input_file);
@@ -209,6 +433,73 @@ auto read_wavefront(Path && p) -> Solid<D> {
     return {};
 }
 
+/* Parallel load, read_wavefront<float>(std::execution::par, path). Files that cannot be mapped load serially */
+template<class D = double, class Policy, class Path> requires std::is_execution_policy_v<std::remove_cvref_t<Policy>>
+auto read_wavefront(Policy && policy, Path && p) -> Solid<D> {
+    if (auto mapped = Mapped_File{ std::filesystem::path{ p } }) {
+        return details::parse_wv_obj<D>(policy, mapped.view());
+    }
+
+    return read_wavefront<D>(std::forward<Path>(p));
+}
+
+/* A run of whole lines, indexes are the file's one based indexes, faces refer to batches before it too */
+template <class T>
+using Obj_Batch = details::Obj_Chunk<T>;
+
+/**
+ * Scans the file batch_bytes at a time and hands every batch to sink in file order, sink returns false to stop.
+ * No Solid is built: batches the sink lets go of are freed, and the mapped text behind them leaves memory, so
+ * the peak is about one batch whatever the file size. False when the file cannot be read.
+ * */
+template <class D = double, class Path, class Sink> requires std::is_invocable_r_v<bool, Sink &, Obj_Batch<D> &&>
+auto stream_wavefront(Path && p, Sink && sink, std::size_t batch_bytes = details::obj_chunk_size) -> bool {
+    auto stream = details::Obj_Stream<D>{};
+
+    if (auto mapped = Mapped_File{ std::filesystem::path{ p } }) {
+        auto text = mapped.view();
+
+        for (auto consumed = std::size_t{}; !std::empty(text);) {
+            auto length = details::cut_lines(text, batch_bytes);
+
+            if (!sink(stream.next(text.substr(0, length)))) {
+                break;
+            }
+
+            consumed += length;
+            text.remove_prefix(length);
+            mapped.release(consumed);
+        }
+
+        return true;
+    }
+
+    auto input_file = std::ifstream{p, std::ifstream::binary};
+
+    if (!input_file) {
+        return false;
+    }
+
+    /* whole lines go to the sink, the partial last one waits for the next block */
+    auto text = std::string{};
+    auto block = std::string(batch_bytes, '\0');
+
+    while (input_file) {
+        input_file.read(std::data(block), static_cast<std::streamsize>(std::size(block)));
+        text.append(std::data(block), static_cast<std::size_t>(input_file.gcount()));
+
+        auto length = input_file ? text.rfind('\n') + 1 : std::size(text); /* npos + 1 is 0, no whole line yet */
+
+        if (length > 0 && !sink(stream.next(std::string_view{ text }.substr(0, length)))) {
+            break;
+        }
+
+        text.erase(0, length);
+    }
+
+    return true;
+}
+
 } // namespace engine::io
 
 #endif //CPP_ENGINE_OBJ_READER_HPP
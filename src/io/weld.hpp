@@ -0,0 +1,316 @@
+#ifndef CPP_ENGINE_WELD_HPP
+#define CPP_ENGINE_WELD_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../geometry/core.hpp"
+
+/**
+ * OBJ corners index position, texture and normal separately, a GPU vertex is the three together. Welding gives
+ * every distinct (v, vt, vn) triple one interleaved vertex, so shared corners are uploaded once.
+ * */
+
+namespace engine::io {
+
+/* Attribute bits, position is always there */
+inline constexpr auto vertex_texture = std::uint32_t{ 1 };
+inline constexpr auto vertex_normal = std::uint32_t{ 2 };
+
+/* Floats per vertex, x y z [u v] [nx ny nz] */
+constexpr auto vertex_floats(std::uint32_t attributes) -> std::size_t {
+    return 3 + (attributes & vertex_texture ? 2 : 0) + (attributes & vertex_normal ? 3 : 0);
+}
+
+struct Interleaved_Mesh {
+    std::vector<float> vertex;
+    std::vector<std::uint32_t> indexes;
+    std::uint32_t attributes = 0;
+
+    [[nodiscard]] auto stride() const -> std::size_t {
+        return sizeof(float) * vertex_floats(attributes);
+    }
+
+    [[nodiscard]] auto vertex_count() const -> std::size_t {
+        return std::size(vertex) / vertex_floats(attributes);
+    }
+};
+
+} // namespace engine::io
+
+namespace engine::io::details {
+
+/* One based v, vt, vn of a corner, 0 for a missing attribute */
+using Corner_Key = std::array<std::uint32_t, 3>;
+
+inline auto hash_corner(Corner_Key const& key) -> std::uint64_t {
+    auto h = key[0] * 0x9e3779b97f4a7c15ull ^ key[1] * 0xc2b2ae3d27d4eb4full ^ key[2] * 0x165667b19e3779f9ull;
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ull;
+    return h ^ (h >> 32);
+}
+
+/**
+ * Open addressing from key to vertex id, linear probing over a power of two table of id + 1, 0 is free.
+ * Sized for every corner at half load it never grows, past half load it doubles and rehashes the keys.
+ * */
+class Corner_Table {
+    std::vector<std::uint32_t> m_slots;
+    std::vector<Corner_Key> m_keys;
+    std::uint64_t m_mask;
+
+public:
+    explicit Corner_Table(std::size_t corners) :
+     m_slots(std::bit_ceil(std::max(corners * 2, std::size_t{ 16 }))),
+     m_mask(std::size(m_slots) - 1)
+    {
+        m_keys.reserve(corners);
+    }
+
+    /* Id of key and whether it was just added */
+    auto insert(Corner_Key const& key) -> std::pair<std::uint32_t, bool> {
+        if ((std::size(m_keys) + 1) * 2 > std::size(m_slots)) {
+            grow();
+        }
+
+        for (auto slot = hash_corner(key) & m_mask;; slot = (slot + 1) & m_mask) {
+            if (m_slots[slot] == 0) {
+                m_keys.push_back(key);
+                m_slots[slot] = static_cast<std::uint32_t>(std::size(m_keys));
+                return { m_slots[slot] - 1, true };
+            }
+
+            if (m_keys[m_slots[slot] - 1] == key) {
+                return { m_slots[slot] - 1, false };
+            }
+        }
+    }
+
+private:
+    auto grow() -> void {
+        m_slots.assign(std::size(m_slots) * 2, 0);
+        m_mask = std::size(m_slots) - 1;
+
+        for (auto id = 0ul; id < std::size(m_keys); ++id) {
+            auto slot = hash_corner(m_keys[id]) & m_mask;
+
+            while (m_slots[slot] != 0) {
+                slot = (slot + 1) & m_mask;
+            }
+            m_slots[slot] = static_cast<std::uint32_t>(id + 1);
+        }
+    }
+};
+
+/* Index of a corner attribute, 0 when the face has none or it points outside the array */
+inline auto corner_index(std::vector<std::size_t> const& indexes, std::size_t corner, std::size_t count) -> std::uint32_t {
+    if (corner >= std::size(indexes) || indexes[corner] == 0 || indexes[corner] > count) {
+        return 0;
+    }
+    return static_cast<std::uint32_t>(indexes[corner]);
+}
+
+/* Interleaved vertex of key, missing attributes as zeros */
+template <class T>
+auto push_vertex(std::vector<float> & out, Corner_Key const& key, std::uint32_t attributes,
+                 std::vector<Vector_3D<T>> const& vertex, std::vector<space2D::Vector_2D<T>> const& uv,
+                 std::vector<Vector_3D<T>> const& normal) -> void {
+    auto position = key[0] ? vertex[key[0] - 1] : Vector_3D<T>{};
+    out.insert(std::end(out), { float(position.x), float(position.y), float(position.z) });
+
+    if (attributes & vertex_texture) {
+        auto coordinate = key[1] ? uv[key[1] - 1] : space2D::Vector_2D<T>{};
+        out.insert(std::end(out), { float(coordinate.x), float(coordinate.y) });
+    }
+
+    if (attributes & vertex_normal) {
+        auto direction = key[2] ? normal[key[2] - 1] : Vector_3D<T>{};
+        out.insert(std::end(out), { float(direction.x), float(direction.y), float(direction.z) });
+    }
+}
+
+} // namespace engine::io::details
+
+namespace engine::io {
+
+/**
+ * Interleaved vertices and fan triangulated indexes of solid, one vertex per distinct corner. Texture and normal
+ * are laid out when the solid has any, corners without one get zeros.
+ * */
+template <class T>
+auto weld(Solid<T> const& solid) -> Interleaved_Mesh {
+    auto mesh = Interleaved_Mesh{};
+    auto corners = std::size_t{};
+    auto triangles = std::size_t{};
+
+    for (auto const& face : solid.faces()) {
+        corners += std::size(face.indexes);
+        triangles += std::size(face.indexes) > 2 ? std::size(face.indexes) - 2 : 0;
+
+        if (!std::empty(face.texture) && !std::empty(solid.uv)) {
+            mesh.attributes |= vertex_texture;
+        }
+        if (!std::empty(face.normal) && !std::empty(solid.normal)) {
+            mesh.attributes |= vertex_normal;
+        }
+    }
+
+    auto table = details::Corner_Table{ corners };
+    auto ids = std::vector<std::uint32_t>{};
+
+    mesh.vertex.reserve(vertex_floats(mesh.attributes) * std::min(corners, std::size(solid.vertex()) * 2));
+    mesh.indexes.reserve(triangles * 3);
+
+    for (auto const& face : solid.faces()) {
+        ids.clear();
+
+        for (auto i = 0ul; i < std::size(face.indexes); ++i) {
+            auto key = details::Corner_Key{
+                details::corner_index(face.indexes, i, std::size(solid.vertex())),
+                mesh.attributes & vertex_texture ? details::corner_index(face.texture, i, std::size(solid.uv)) : 0,
+                mesh.attributes & vertex_normal ? details::corner_index(face.normal, i, std::size(solid.normal)) : 0
+            };
+
+            auto [ id, added ] = table.insert(key);
+            ids.push_back(id);
+
+            if (added) {
+                details::push_vertex(mesh.vertex, key, mesh.attributes, solid.vertex(), solid.uv, solid.normal);
+            }
+        }
+
+        for (auto i = 2ul; i < std::size(ids); ++i) {
+            mesh.indexes.insert(std::end(mesh.indexes), { ids[0], ids[i - 1], ids[i] });
+        }
+    }
+
+    return mesh;
+}
+
+/**
+ * weld() a batch at a time, for meshes uploaded while they are read. Vertex ids run on across batches, so the
+ * indexes of a batch may point at vertices of the batches before it.
+ * Exporters write every v, then vt, then vn before the first f, so positions, uv and normals are kept until the
+ * first batch with faces settles the layout: texture and normal when its faces use them, as weld() decides.
+ * Without either the kept positions go out then and later ones pass through as they come, nothing is kept. The
+ * output is then the file's own positions and indexes, the same triangles as weld() but not its first use order.
+ * With them memory is not bounded: any face may use any earlier v, vt or vn, so all of them stay here, plus one
+ * table entry per welded vertex. That grows with the mesh, roughly 50 bytes per vertex with uv and normals, still
+ * far less than the text and a whole Solid. The output then equals weld() of the whole file.
+ * */
+template <class T>
+class Stream_Welder {
+    std::vector<Vector_3D<T>> m_vertex;
+    std::vector<space2D::Vector_2D<T>> m_uv;
+    std::vector<Vector_3D<T>> m_normal;
+
+    details::Corner_Table m_table{ 0 };
+    std::vector<std::uint32_t> m_ids;
+    std::optional<std::uint32_t> m_attributes;
+
+    /* positions passed through so far, the only ones faces may use without attributes */
+    std::size_t m_passed = 0;
+
+public:
+    template <class Batch>
+    auto append(Batch const& batch) -> Interleaved_Mesh {
+        auto mesh = Interleaved_Mesh{};
+
+        if (!m_attributes || *m_attributes != 0) {
+            m_vertex.insert(std::end(m_vertex), std::begin(batch.vertex), std::end(batch.vertex));
+            m_uv.insert(std::end(m_uv), std::begin(batch.uv), std::end(batch.uv));
+            m_normal.insert(std::end(m_normal), std::begin(batch.normal), std::end(batch.normal));
+        }
+
+        if (!m_attributes) {
+            if (std::empty(batch.faces)) {
+                return mesh;
+            }
+
+            m_attributes = settle_layout(batch);
+
+            if (*m_attributes == 0) {
+                pass_through(mesh, m_vertex);
+                m_vertex = {};
+                m_uv = {};
+                m_normal = {};
+            }
+        } else if (*m_attributes == 0) {
+            pass_through(mesh, batch.vertex);
+        }
+
+        mesh.attributes = *m_attributes;
+
+        for (auto const& face : batch.faces) {
+            m_ids.clear();
+
+            for (auto i = 0ul; i < std::size(face.indexes); ++i) {
+                if (mesh.attributes == 0) {
+                    m_ids.push_back(details::corner_index(face.indexes, i, m_passed));
+                    continue;
+                }
+
+                auto key = details::Corner_Key{
+                    details::corner_index(face.indexes, i, std::size(m_vertex)),
+                    mesh.attributes & vertex_texture ? details::corner_index(face.texture, i, std::size(m_uv)) : 0,
+                    mesh.attributes & vertex_normal ? details::corner_index(face.normal, i, std::size(m_normal)) : 0
+                };
+
+                auto [ id, added ] = m_table.insert(key);
+                m_ids.push_back(id + 1);
+
+                if (added) {
+                    details::push_vertex(mesh.vertex, key, mesh.attributes, m_vertex, m_uv, m_normal);
+                }
+            }
+
+            /* passed through positions not read yet are not on the GPU yet either */
+            if (std::ranges::find(m_ids, 0u) != std::end(m_ids)) {
+                continue;
+            }
+
+            for (auto i = 2ul; i < std::size(m_ids); ++i) {
+                mesh.indexes.insert(std::end(mesh.indexes), { m_ids[0] - 1, m_ids[i - 1] - 1, m_ids[i] - 1 });
+            }
+        }
+
+        return mesh;
+    }
+
+private:
+    /* Texture and normal when some face of batch uses one that was read */
+    template <class Batch>
+    auto settle_layout(Batch const& batch) const -> std::uint32_t {
+        auto attributes = std::uint32_t{};
+
+        for (auto const& face : batch.faces) {
+            if (!std::empty(face.texture) && !std::empty(m_uv)) {
+                attributes |= vertex_texture;
+            }
+            if (!std::empty(face.normal) && !std::empty(m_normal)) {
+                attributes |= vertex_normal;
+            }
+        }
+
+        return attributes;
+    }
+
+    auto pass_through(Interleaved_Mesh & mesh, std::vector<Vector_3D<T>> const& vertex) -> void {
+        mesh.vertex.reserve(std::size(mesh.vertex) + 3 * std::size(vertex));
+
+        for (auto const& position : vertex) {
+            mesh.vertex.insert(std::end(mesh.vertex), { float(position.x), float(position.y), float(position.z) });
+        }
+        m_passed += std::size(vertex);
+    }
+};
+
+} // namespace engine::io
+
+#endif //CPP_ENGINE_WELD_HPP
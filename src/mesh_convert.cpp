@@ -0,0 +1,33 @@
+#include <cstdlib>
+#include <filesystem>
+
+#include <fmt/core.h>
+
+#include "io/mesh_cache.hpp"
+
+auto main(int argc, char ** argv) -> int {
+    if (argc < 2 || argc > 3) {
+        fmt::print("usage: mesh-convert <model.obj> [model.obj.mesh]\n");
+        return EXIT_FAILURE;
+    }
+
+    auto source = std::filesystem::path{ argv[1] };
+    auto cache = argc == 3 ? std::filesystem::path{ argv[2] } : engine::io::mesh_cache_path(source);
+
+    auto mesh = engine::io::convert_wavefront(source);
+
+    if (mesh.vertex_count() == 0) {
+        fmt::print("Err(could not load {})\n", source.string());
+        return EXIT_FAILURE;
+    }
+
+    if (!mesh.write(cache)) {
+        fmt::print("Err(could not write {})\n", cache.string());
+        return EXIT_FAILURE;
+    }
+
+    fmt::print("Vertex {} ({} bytes) Triangles {} Index {} bytes -> {}\n", mesh.vertex_count(), mesh.vertex_stride(),
+               mesh.index_count() / 3, mesh.index_size(), cache.string());
+
+    return EXIT_SUCCESS;
+}
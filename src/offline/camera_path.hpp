@@ -0,0 +1,110 @@
+#ifndef CPP_ENGINE_OFFLINE_CAMERA_PATH_HPP
+#define CPP_ENGINE_OFFLINE_CAMERA_PATH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../geometry/core.hpp"
+
+namespace engine::offline {
+
+/* Model placement for one frame, same parameters the wavefront runner exposes. Angles in degrees */
+struct Camera_Pose {
+    double angle_x, angle_y, angle_z;
+    double move_x, move_y;
+    double scale;
+
+    /* Model centered on screen, y mirrored and z flipped so closer is smaller */
+    [[nodiscard]] auto transform(Vector_3D<double> const& center, std::size_t width, std::size_t height) const -> Mat4 {
+        return Mat4::translate(width / 2.0 + move_x, height / 2.0 + move_y, center.z) *
+               Mat4::scale(scale, -scale, -scale) *
+               Mat4::rotate(axis::Z, Degrees{ angle_z }) *
+               Mat4::rotate(axis::Y, Degrees{ angle_y }) *
+               Mat4::rotate(axis::X, Degrees{ angle_x }) *
+               Mat4::translate(-center.x, -center.y, -center.z);
+    }
+
+    /**
+     * The same framing seen from distance pixels in front of the center, to clip space.
+     * w is distance plus the depth of the point, after the divide points at the center depth keep their transform
+     * size and z / w keeps closer smaller. Distance must exceed the scaled model radius to keep w positive.
+     * */
+    [[nodiscard]] auto projection(Vector_3D<double> const& center, std::size_t width, std::size_t height,
+                                  double distance) const -> Mat4 {
+        auto x = width / 2.0 + move_x, y = height / 2.0 + move_y;
+
+        return Mat4::from_rows({{
+            { distance, 0,        x, x * distance },
+            { 0,        distance, y, y * distance },
+            { 0,        0,        1, 0            },
+            { 0,        0,        1, distance     }
+        }}) * eye(center);
+    }
+
+    /* transform without the move to the screen, the center lands on the origin */
+    [[nodiscard]] auto eye(Vector_3D<double> const& center) const -> Mat4 {
+        return Mat4::scale(scale, -scale, -scale) *
+               Mat4::rotate(axis::Z, Degrees{ angle_z }) *
+               Mat4::rotate(axis::Y, Degrees{ angle_y }) *
+               Mat4::rotate(axis::X, Degrees{ angle_x }) *
+               Mat4::translate(-center.x, -center.y, -center.z);
+    }
+};
+
+/**
+ * Poses keyed over normalized time [0, 1], linearly interpolated in between.
+ * A single key holds the pose for the whole path.
+ * */
+struct Camera_Path {
+    struct Key {
+        double time;
+        Camera_Pose pose;
+    };
+
+    std::vector<Key> keys;
+
+    /* Full turn about Y, optionally tilted about X */
+    static auto orbit(double scale, double tilt = 0, double turns = 1) -> Camera_Path {
+        return { .keys = {
+            { 0.0, { tilt, 0, 0, 0, 0, scale } },
+            { 1.0, { tilt, 360 * turns, 0, 0, 0, scale } }
+        }};
+    }
+
+    /* Pose of frame out of frames, the last frame lands on the last key */
+    [[nodiscard]] auto at(std::size_t frame, std::size_t frames) const -> Camera_Pose {
+        return at(frames > 1 ? double(frame) / double(frames - 1) : 0.0);
+    }
+
+    [[nodiscard]] auto at(double time) const -> Camera_Pose {
+        if (std::empty(keys)) {
+            return { 0, 0, 0, 0, 0, 1 };
+        }
+
+        auto next = std::ranges::upper_bound(keys, time, {}, &Key::time);
+
+        if (next == std::begin(keys)) {
+            return keys.front().pose;
+        }
+        if (next == std::end(keys)) {
+            return keys.back().pose;
+        }
+
+        auto const& [ t0, a ] = *std::prev(next);
+        auto const& [ t1, b ] = *next;
+        auto f = (time - t0) / (t1 - t0);
+
+        auto mix = [f](double u, double v) { return std::lerp(u, v, f); };
+
+        return {
+            mix(a.angle_x, b.angle_x), mix(a.angle_y, b.angle_y), mix(a.angle_z, b.angle_z),
+            mix(a.move_x, b.move_x), mix(a.move_y, b.move_y),
+            mix(a.scale, b.scale)
+        };
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_OFFLINE_CAMERA_PATH_HPP
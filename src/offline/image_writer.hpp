@@ -0,0 +1,113 @@
+#ifndef CPP_ENGINE_OFFLINE_IMAGE_WRITER_HPP
+#define CPP_ENGINE_OFFLINE_IMAGE_WRITER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include "../utility/bounded_queue.hpp"
+#include "./stats.hpp"
+
+namespace engine::offline {
+
+enum class Image_Format {
+    png,
+    raw /* tightly packed RGBA8 rows, no header */
+};
+
+struct Image_Job {
+    std::filesystem::path path;
+    std::size_t width;
+    std::size_t height;
+    std::vector<std::uint8_t> pixels;
+};
+
+/**
+ * Writes images on a background thread so encoding and disk never stall the rasterizer.
+ * At most depth images wait in memory, write() blocks beyond that.
+ * */
+class Image_Writer {
+    Image_Format m_format;
+    util::Bounded_Queue<Image_Job> m_jobs;
+
+    /* only touched by the worker until finish() joins it */
+    std::size_t m_written;
+    std::size_t m_failed;
+    Stage_Time m_time;
+
+    std::thread m_worker;
+
+public:
+    explicit Image_Writer(Image_Format format, std::size_t depth = 4) :
+        m_format(format),
+        m_jobs(depth),
+        m_written(0),
+        m_failed(0),
+        m_time(),
+        m_worker([this] { work(); })
+    {}
+
+    Image_Writer(Image_Writer const&) = delete;
+    auto operator=(Image_Writer const&) -> Image_Writer & = delete;
+
+    ~Image_Writer() {
+        finish();
+    }
+
+    auto write(Image_Job job) -> void {
+        m_jobs.push(std::move(job));
+    }
+
+    /* Drains the queue and stops the thread, counters are final afterwards */
+    auto finish() -> void {
+        m_jobs.close();
+
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+    [[nodiscard]] auto written() const -> std::size_t { return m_written; }
+    [[nodiscard]] auto failed() const -> std::size_t { return m_failed; }
+    [[nodiscard]] auto time() const -> Stage_Time const& { return m_time; }
+
+    [[nodiscard]] auto extension() const -> char const* {
+        return m_format == Image_Format::png ? ".png" : ".rgba";
+    }
+
+private:
+    auto work() -> void {
+        while (auto job = m_jobs.pop()) {
+            auto ok = timed(m_time, [this, &job] { return save(*job); });
+
+            if (ok) {
+                ++m_written;
+            } else {
+                ++m_failed;
+                fmt::print("Err(could not write {})\n", job->path.string());
+            }
+        }
+    }
+
+    auto save(Image_Job const& job) const -> bool {
+        if (m_format == Image_Format::png) {
+            auto image = sf::Image{};
+            image.create(unsigned(job.width), unsigned(job.height), std::data(job.pixels));
+            return image.saveToFile(job.path.string());
+        }
+
+        auto output = std::ofstream{ job.path, std::ios::binary };
+        output.write(reinterpret_cast<char const*>(std::data(job.pixels)), std::streamsize(std::size(job.pixels)));
+        return output.good();
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_OFFLINE_IMAGE_WRITER_HPP
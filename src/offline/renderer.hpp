@@ -0,0 +1,245 @@
+#ifndef CPP_ENGINE_OFFLINE_RENDERER_HPP
+#define CPP_ENGINE_OFFLINE_RENDERER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <execution>
+#include <filesystem>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include "../geometry/core.hpp"
+#include "../pixel-buffer.hpp"
+#include "../depth-buffer.hpp"
+#include "../draw.hpp"
+#include "../raster/cull.hpp"
+#include "../raster/tiled.hpp"
+#include "../raster/textured.hpp"
+#include "../raster/triangle.hpp"
+#include "./camera_path.hpp"
+#include "./image_writer.hpp"
+#include "./stats.hpp"
+
+namespace engine::offline {
+
+enum class Draw_Mode {
+    wire,   /* serial discrete_line_plot */
+    tiled,  /* Tiled_Rasterizer */
+    filled,   /* z-tested, flat shaded */
+    solid,    /* fill_triangle without depth, back faces culled, for convex meshes */
+    textured  /* z-tested, textured from the OBJ's vt */
+};
+
+struct Render_Options {
+    std::size_t width = 800;
+    std::size_t height = 600;
+    std::size_t frames = 120;
+    Draw_Mode mode = Draw_Mode::tiled;
+    std::filesystem::path texture = {}; /* textured mode, a checker board when empty or unreadable */
+
+    std::filesystem::path output = {}; /* nothing is written when empty */
+    Image_Format format = Image_Format::png;
+    std::size_t queue_depth = 4;
+};
+
+namespace details {
+
+/* Faces fanned into triangles of draw_textured_mesh, corners without a vt use the zero uv appended last */
+template <class T>
+auto textured_faces(Solid<T> const& solid) -> std::vector<Textured_Face> {
+    auto faces = std::vector<Textured_Face>{};
+    auto zero_uv = std::uint32_t(std::size(solid.uv));
+
+    for (auto const& face : solid.faces()) {
+        auto corner = [&face, zero_uv](std::size_t k) {
+            auto texture = k < std::size(face.texture) ? face.texture[k] : 0;
+            return std::pair{ std::uint32_t(face.indexes[k] - 1), texture == 0 || texture > zero_uv ? zero_uv : std::uint32_t(texture - 1) };
+        };
+
+        for (auto i = 2ul; i < std::size(face.indexes); ++i) {
+            auto [ v0, t0 ] = corner(0);
+            auto [ v1, t1 ] = corner(i - 1);
+            auto [ v2, t2 ] = corner(i);
+
+            faces.push_back({ { v0, v1, v2 }, { t0, t1, t2 } });
+        }
+    }
+
+    return faces;
+}
+
+/* RGBA8 texels of the texture option, an 8 x 8 checker board of 64 x 64 texels without one */
+inline auto load_texels(std::filesystem::path const& path) -> std::tuple<std::vector<std::uint8_t>, int, int> {
+    if (auto image = sf::Image{}; !path.empty() && image.loadFromFile(path.string())) {
+        auto [ width, height ] = image.getSize();
+        auto pixels = image.getPixelsPtr();
+
+        return { std::vector<std::uint8_t>(pixels, pixels + std::size_t(width) * height * 4), int(width), int(height) };
+    }
+
+    constexpr auto size = 64, cell = 8;
+    auto texels = std::vector<std::uint8_t>(size * size * 4);
+
+    for (auto y = 0; y < size; ++y) {
+        for (auto x = 0; x < size; ++x) {
+            auto level = std::uint8_t((x / cell + y / cell) % 2 ? 220 : 60);
+            std::ranges::copy(std::array<std::uint8_t, 4>{ level, level, level, 255 }, std::begin(texels) + (y * size + x) * 4);
+        }
+    }
+
+    return { std::move(texels), size, size };
+}
+
+} // namespace details
+
+/**
+ * Renders frames of solid along path without any window, the software path only.
+ * Each frame is transformed, cleared and rasterized on the calling thread, then handed to an Image_Writer.
+ * */
+template <class T>
+auto render(Solid<T> const& solid, Camera_Path const& path, Render_Options const& options) -> Render_Report {
+    auto report = Render_Report{};
+
+    if (std::empty(solid.vertex())) {
+        return report;
+    }
+
+    auto box = solid.bounding_box();
+
+    auto center = Vector_3D<double>{
+        std::midpoint(double(box.min.x), double(box.max.x)),
+        std::midpoint(double(box.min.y), double(box.max.y)),
+        std::midpoint(double(box.min.z), double(box.max.z))
+    };
+    auto radius = std::hypot(double(box.max.x) - center.x, double(box.max.y) - center.y, double(box.max.z) - center.z);
+
+    auto view = solid;
+    auto pixels = Basic_RGBA_Buffer(options.width, options.height, 255u);
+    auto depth = Depth_Buffer<float>(options.width, options.height);
+    auto raster = Tiled_Rasterizer<>(options.width, options.height);
+    auto culler = Face_Culler<T>{};
+
+    /* textured mode only, uv gets the zero coordinate textured_faces points bare corners at */
+    auto textured = options.mode == Draw_Mode::textured;
+    auto faces = textured ? details::textured_faces(solid) : std::vector<Textured_Face>{};
+    auto uv = textured ? solid.uv : std::vector<space2D::Vector_2D<T>>{};
+    auto [ texels, texture_width, texture_height ] = textured ? details::load_texels(options.texture)
+                                                             : std::tuple<std::vector<std::uint8_t>, int, int>{};
+    auto texture = Texture_View{ std::data(texels), texture_width, texture_height };
+
+    /* textured mode is seen in perspective, clip w feeds the perspective correct interpolation */
+    auto clip = std::vector<Vector_4D<T>>(textured ? std::size(solid.vertex()) : 0);
+    auto w = std::vector<float>(std::size(clip));
+
+    uv.push_back({});
+
+    auto writing = !options.output.empty();
+    auto writer = Image_Writer(options.format, options.queue_depth);
+
+    if (writing) {
+        std::filesystem::create_directories(options.output);
+    }
+
+    auto white = std::array<std::uint8_t, 4>{ 255, 255, 255, 255 };
+    auto black = std::array<std::uint8_t, 4>{ 0, 0, 0, 255 };
+
+    auto start = Clock::now();
+
+    for (auto frame = 0ul; frame < options.frames; ++frame) {
+        auto pose = path.at(frame, options.frames);
+
+        timed(report.transform, [&] {
+            if (textured) {
+                /* three radii away, w stays between two and four radii so nothing needs clipping */
+                auto projection = pose.projection(center, options.width, options.height, 3 * std::max(pose.scale * radius, 1.0));
+
+                std::transform(std::execution::par, std::cbegin(solid.vertex()), std::cend(solid.vertex()), std::begin(clip),
+                               [&projection](auto const& v) { return apply_projective(v, projection); });
+                std::transform(std::execution::par, std::cbegin(clip), std::cend(clip), std::begin(w),
+                               [](auto const& v) { return float(v.w); });
+
+                view.edit_vertices([&clip](auto vertex) {
+                    std::transform(std::execution::par, std::cbegin(clip), std::cend(clip), std::begin(vertex),
+                                   [](auto const& v) { return perspective_divide(v); });
+                });
+            } else {
+                auto transform = pose.transform(center, options.width, options.height);
+
+                view.edit_vertices([&solid, &transform](auto vertex) {
+                    transform_points<T>(std::execution::par, solid.vertex(), transform, vertex);
+                });
+            }
+
+            /* the culler reads the cached box */
+            if (options.mode == Draw_Mode::solid) {
+                view.update_bounds();
+            }
+        });
+
+        timed(report.clear, [&] {
+            pixels.clear(white);
+
+            if (options.mode == Draw_Mode::filled || textured) {
+                depth.clear();
+            }
+        });
+
+        timed(report.raster, [&] {
+            switch (options.mode) {
+                case Draw_Mode::wire:
+                    draw_solid(pixels, view, black);
+                    break;
+                case Draw_Mode::tiled:
+                    draw_solid(raster, view, black);
+                    raster.flush(pixels);
+                    break;
+                case Draw_Mode::filled:
+                    draw_solid(pixels, depth, view, [&view](std::size_t face) { return flat_shade(view, face); });
+                    break;
+                case Draw_Mode::solid:
+                    fill_solid(pixels, view, culler.cull(std::execution::par, view, options.width, options.height),
+                               [&view](std::size_t face) { return flat_shade(view, face); });
+                    break;
+                case Draw_Mode::textured:
+                    draw_textured_mesh(pixels, depth, view.vertex(), w, uv, faces, texture);
+                    break;
+            }
+        });
+
+        timed(report.copy, [&] {
+            for (auto word : pixels.container) {
+                report.checksum = (report.checksum ^ word) * 1099511628211ull;
+            }
+
+            if (writing) {
+                writer.write({
+                    .path = options.output / fmt::format("frame_{:05}{}", frame, writer.extension()),
+                    .width = options.width,
+                    .height = options.height,
+                    .pixels = std::vector<std::uint8_t>(std::data(pixels), std::data(pixels) + std::size(pixels))
+                });
+            }
+        });
+    }
+
+    writer.finish();
+
+    report.wall = Clock::now() - start;
+    report.frames = options.frames;
+    report.written = writer.written();
+    report.failed = writer.failed();
+    report.write = writer.time();
+
+    return report;
+}
+
+}
+
+#endif //CPP_ENGINE_OFFLINE_RENDERER_HPP
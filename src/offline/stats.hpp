@@ -0,0 +1,89 @@
+#ifndef CPP_ENGINE_OFFLINE_STATS_HPP
+#define CPP_ENGINE_OFFLINE_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <fmt/core.h>
+
+namespace engine::offline {
+
+using Clock = std::chrono::steady_clock;
+
+/* Accumulated wall time of one pipeline stage */
+struct Stage_Time {
+    Clock::duration total = {};
+    std::size_t count = {};
+
+    auto add(Clock::duration elapsed) -> void {
+        total += elapsed;
+        ++count;
+    }
+
+    [[nodiscard]] auto total_ms() const -> double {
+        return std::chrono::duration<double, std::milli>(total).count();
+    }
+
+    [[nodiscard]] auto mean_ms() const -> double {
+        return count ? total_ms() / double(count) : 0.0;
+    }
+};
+
+/* Runs fn and charges its wall time to stage */
+template <class Fn>
+auto timed(Stage_Time & stage, Fn && fn) -> decltype(auto) {
+    struct Charge {
+        Stage_Time & stage;
+        Clock::time_point start;
+        ~Charge() { stage.add(Clock::now() - start); }
+    } charge{ stage, Clock::now() };
+
+    return std::forward<Fn>(fn)();
+}
+
+struct Render_Report {
+    std::size_t frames = {};
+    std::size_t written = {};
+    std::size_t failed = {};
+
+    Stage_Time transform;
+    Stage_Time clear;
+    Stage_Time raster;
+    Stage_Time copy;    /* frame hashed and handed to the writer, includes waiting on a full queue */
+    Stage_Time write;   /* encoding and disk, on the writer thread */
+    Clock::duration wall = {};
+
+    /**
+     * Word-wise FNV style hash, FNV-1a's offset and prime applied per 32 bit pixel word rather than per byte, so
+     * it matches no FNV-1a implementation. Every frame in order, equal output gives an equal checksum.
+     * */
+    std::uint64_t checksum = 14695981039346656037ull;
+
+    [[nodiscard]] auto fps() const -> double {
+        auto seconds = std::chrono::duration<double>(wall).count();
+        return seconds > 0 ? double(frames) / seconds : 0.0;
+    }
+
+    auto print() const -> void {
+        fmt::print("{} frames in {:.1f} ms, {:.1f} fps, {} written, {} failed\n",
+                   frames, std::chrono::duration<double, std::milli>(wall).count(), fps(), written, failed);
+
+        auto row = [](char const* name, Stage_Time const& stage) {
+            fmt::print("  {:<10} {:>10.3f} ms/frame {:>12.1f} ms total\n", name, stage.mean_ms(), stage.total_ms());
+        };
+
+        row("transform", transform);
+        row("clear", clear);
+        row("raster", raster);
+        row("copy", copy);
+        row("write", write);
+
+        fmt::print("  checksum   {:016x}\n", checksum);
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_OFFLINE_STATS_HPP
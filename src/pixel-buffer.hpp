@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <vector>
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
 #include "utility/accessors.hpp"
 
@@ -13,6 +17,122 @@ auto flat_index(std::size_t x, std::size_t y, std::size_t width, std::size_t len
     return (y * width + x) * length;
 }
 
+/* Inclusive pixel rectangle */
+struct Clip_Rect {
+    long x0, y0;
+    long x1, y1;
+
+    constexpr auto contains(long x, long y) const noexcept -> bool {
+        return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+    }
+};
+
+/**
+ * Coarse record of what changed in a pixel buffer.
+ * Drawn tiles hold something other than the clear color, pending tiles differ from the last upload.
+ * Draw calls mark the bounding box of what they write, set() alone does not mark.
+ * */
+struct Dirty_Tiles {
+    static constexpr std::size_t tile_size = 32;
+
+    std::size_t width;
+    std::size_t height;
+    std::size_t columns;
+    std::size_t rows;
+    std::vector<std::uint8_t> drawn;
+    std::vector<std::uint8_t> pending;
+
+    /* Nothing is drawn yet, but the target has never seen the buffer */
+    Dirty_Tiles(std::size_t width, std::size_t height) :
+        width(width),
+        height(height),
+        columns((width + tile_size - 1) / tile_size),
+        rows((height + tile_size - 1) / tile_size),
+        drawn(columns * rows, 0u),
+        pending(columns * rows, 1u)
+    {}
+
+    /* Clamped to the buffer */
+    auto mark(Clip_Rect const& rect) -> void {
+        auto x0 = std::max(rect.x0, 0l), y0 = std::max(rect.y0, 0l);
+        auto x1 = std::min(rect.x1, long(width) - 1), y1 = std::min(rect.y1, long(height) - 1);
+
+        if (x0 > x1 || y0 > y1) {
+            return;
+        }
+
+        for (auto row = std::size_t(y0) / tile_size; row <= std::size_t(y1) / tile_size; ++row) {
+            auto first = row * columns + std::size_t(x0) / tile_size, last = row * columns + std::size_t(x1) / tile_size;
+
+            std::fill(std::next(std::begin(drawn), first), std::next(std::begin(drawn), last + 1), 1u);
+            std::fill(std::next(std::begin(pending), first), std::next(std::begin(pending), last + 1), 1u);
+        }
+    }
+
+    /* The whole buffer was just filled with the clear color */
+    auto clear_all() -> void {
+        std::ranges::fill(drawn, 0u);
+        std::ranges::fill(pending, 1u);
+    }
+
+    /* Calls fill(rect) over every drawn tile, they hold the clear color again afterwards */
+    template <class Fill>
+    auto clear_drawn(Fill && fill) -> void {
+        for_each_rect(drawn, fill);
+        std::ranges::transform(drawn, pending, std::begin(pending), [](auto d, auto p) { return std::uint8_t(d | p); });
+        std::ranges::fill(drawn, 0u);
+    }
+
+    /* Calls upload(rect) over every pending tile, the target is in sync afterwards */
+    template <class Upload>
+    auto upload_pending(Upload && upload) -> void {
+        for_each_rect(pending, upload);
+        std::ranges::fill(pending, 0u);
+    }
+
+    /* Runs of set tiles per tile row, identical runs on consecutive rows are merged into one rect */
+    template <class Rect_Fn>
+    auto for_each_rect(std::vector<std::uint8_t> const& mask, Rect_Fn && fn) const -> void {
+        auto open = std::vector<Clip_Rect>{}, next = std::vector<Clip_Rect>{};
+
+        auto pixel_rect = [this](std::size_t c0, std::size_t r0, std::size_t c1, std::size_t r1) -> Clip_Rect {
+            return {
+                long(c0 * tile_size), long(r0 * tile_size),
+                long(std::min(c1 * tile_size, width)) - 1, long(std::min(r1 * tile_size, height)) - 1
+            };
+        };
+
+        for (auto row = 0ul; row <= rows; ++row) {
+            next.clear();
+
+            for (auto column = 0ul; row < rows && column < columns; ++column) {
+                if (!mask[row * columns + column]) {
+                    continue;
+                }
+
+                auto end = column;
+                while (end < columns && mask[row * columns + end]) {
+                    ++end;
+                }
+
+                auto run = pixel_rect(column, row, end, row + 1);
+                auto same = std::ranges::find_if(open, [&run](auto const& r) { return r.x0 == run.x0 && r.x1 == run.x1; });
+
+                if (same != std::end(open)) {
+                    run.y0 = same->y0;
+                    open.erase(same);
+                }
+
+                next.push_back(run);
+                column = end;
+            }
+
+            std::ranges::for_each(open, fn); /* runs that did not continue on this row */
+            std::swap(open, next);
+        }
+    }
+};
+
 template <class Pixel_Type, std::size_t Length>
 struct Buffer_2D : Accessors_For<Buffer_2D<Pixel_Type, Length>> {
     using Pixel_Buffer = std::vector<Pixel_Type>;
@@ -20,25 +140,155 @@ struct Buffer_2D : Accessors_For<Buffer_2D<Pixel_Type, Length>> {
     Pixel_Buffer container;
     std::size_t width;
     std::size_t height;
+    Dirty_Tiles dirty;
+    std::array<Pixel_Type, Length> clear_color;
 
     Buffer_2D(std::size_t width, std::size_t height, Pixel_Type value = {})
-        : width(width), height(height), container(Pixel_Buffer(width * height * Length, value))
+        : width(width), height(height), container(Pixel_Buffer(width * height * Length, value)),
+          dirty(width, height), clear_color()
+    {
+        std::ranges::fill(clear_color, value);
+    }
+
+    auto mark_dirty(Clip_Rect const& rect) -> void {
+        dirty.mark(rect);
+    }
+
+    /* Caller guarantees x < width and y < height */
+    auto set_unchecked(std::size_t x, std::size_t y, Pixel_Type value) -> void {
+        container[flat_index(x, y, width, Length)] = value;
+    }
+
+    auto set_unchecked(std::size_t x, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
+        std::copy_n(std::begin(value), std::size(value),
+                    std::next(std::begin(container), flat_index(x, y, width, Length))); // data.begin() + flat_index(...)
+    }
+
+    /* Negative coordinates wrap around and fail the test as well */
+    auto set(std::size_t x, std::size_t y, Pixel_Type value) -> void {
+        if (x < width && y < height) [[likely]] {
+            set_unchecked(x, y, value);
+        }
+    }
+
+    auto set(std::size_t x, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
+        if (x < width && y < height) [[likely]] {
+            set_unchecked(x, y, value);
+        }
+    }
+
+    /* Only the tiles drawn since the last clear are refilled, unless the color changes */
+    auto clear(std::array<Pixel_Type, Length> const& value) -> void {
+        if (value != clear_color) {
+            for (auto pixel = std::begin(container); pixel != std::end(container); pixel += Length) {
+                std::ranges::copy(value, pixel);
+            }
+            clear_color = value;
+            dirty.clear_all();
+            return;
+        }
+
+        dirty.clear_drawn([this, &value](Clip_Rect const& rect) {
+            for (auto y = rect.y0; y <= rect.y1; ++y) {
+                fill_span(rect.x0, rect.x1 + 1, y, value);
+            }
+        });
+    }
+
+    /* Pixels [x0, x1) of row y, no bounds check */
+    auto fill_span(std::size_t x0, std::size_t x1, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
+        for (auto x = x0; x < x1; ++x) {
+            set_unchecked(x, y, value);
+        }
+    }
+};
+
+namespace details {
+
+/* Bytes of the packed words, the container the generic RGBA8 buffer would have */
+struct Packed_Byte_View {
+    template <class Buffer>
+    constexpr auto operator()(Buffer buffer) const noexcept {
+        using Byte = std::conditional_t<std::is_const_v<std::remove_pointer_t<Buffer>>, std::uint8_t const, std::uint8_t>;
+        return std::span<Byte>(reinterpret_cast<Byte *>(std::data(buffer->container)), std::size(buffer->container) * 4);
+    }
+};
+
+} // namespace details
+
+/**
+ * RGBA8 stores one packed word per pixel, a pixel write is a single store and clears are word fills.
+ * Words hold the four bytes in memory order, so the byte view matches the generic layout
+ * and data() can still be handed to sf::Texture::update as is.
+ * */
+template <>
+struct Buffer_2D<std::uint8_t, 4> : Accessors_For<Buffer_2D<std::uint8_t, 4>, details::Packed_Byte_View> {
+    using Pixel_Type = std::uint8_t;
+    using Pixel_Word = std::uint32_t;
+    using Pixel_Buffer = std::vector<Pixel_Word>;
+
+    static constexpr std::size_t Length = 4;
+
+    Pixel_Buffer container;
+    std::size_t width;
+    std::size_t height;
+    Dirty_Tiles dirty;
+    Pixel_Word clear_color;
+
+    Buffer_2D(std::size_t width, std::size_t height, Pixel_Type value = {})
+        : container(Pixel_Buffer(width * height, value * 0x01010101u)), width(width), height(height),
+          dirty(width, height), clear_color(value * 0x01010101u)
     {}
 
+    [[nodiscard]] static constexpr auto pack(std::array<Pixel_Type, Length> const& value) noexcept -> Pixel_Word {
+        return std::bit_cast<Pixel_Word>(value);
+    }
+
+    /* Caller guarantees x < width and y < height */
+    auto set_unchecked(std::size_t x, std::size_t y, Pixel_Type value) -> void {
+        data()[flat_index(x, y, width, Length)] = value;
+    }
+
+    auto set_unchecked(std::size_t x, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
+        container[y * width + x] = pack(value);
+    }
+
     auto set(std::size_t x, std::size_t y, Pixel_Type value) -> void {
-        auto index = flat_index(x, y, width, Length);
-        if (x >= 0 && x < width && y >= 0 && y < height) [[likely]] { // @TODO remove check
-            container[index] = value;
+        if (x < width && y < height) [[likely]] {
+            set_unchecked(x, y, value);
         }
     }
 
     auto set(std::size_t x, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
-        auto index = flat_index(x, y, width, Length);
-        if (x >= 0 && x < width && y >= 0 && y < height
-            && index < std::size(container) - std::size(value)) [[likely]] { // @TODO remove check
-            std::copy_n(std::begin(value), std::size(value),
-                        std::next(std::begin(container), index)); // data.begin() + flat_index(...)
+        if (x < width && y < height) [[likely]] {
+            set_unchecked(x, y, value);
+        }
+    }
+
+    auto mark_dirty(Clip_Rect const& rect) -> void {
+        dirty.mark(rect);
+    }
+
+    /* Only the tiles drawn since the last clear are refilled, unless the color changes */
+    auto clear(std::array<Pixel_Type, Length> const& value) -> void {
+        if (auto word = pack(value); word != clear_color) {
+            std::ranges::fill(container, word);
+            clear_color = word;
+            dirty.clear_all();
+            return;
         }
+
+        dirty.clear_drawn([this, &value](Clip_Rect const& rect) {
+            for (auto y = rect.y0; y <= rect.y1; ++y) {
+                fill_span(rect.x0, rect.x1 + 1, y, value);
+            }
+        });
+    }
+
+    /* Pixels [x0, x1) of row y, no bounds check */
+    auto fill_span(std::size_t x0, std::size_t x1, std::size_t y, std::array<Pixel_Type, Length> const& value) -> void {
+        std::fill(std::next(std::begin(container), y * width + x0), std::next(std::begin(container), y * width + x1),
+                  pack(value));
     }
 };
 
@@ -0,0 +1,348 @@
+#ifndef CPP_ENGINE_RASTER_CULL_HPP
+#define CPP_ENGINE_RASTER_CULL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "../geometry/core.hpp"
+#include "../pixel-buffer.hpp"
+#include "../depth-buffer.hpp"
+#include "../draw.hpp"
+#include "./fill.hpp"
+#include "./tiled.hpp"
+#include "./triangle.hpp"
+
+namespace engine {
+
+/* Winding of front faces as seen on screen, x right and y down */
+enum class Front_Face {
+    counter_clockwise,
+    clockwise
+};
+
+struct Cull_Options {
+    bool back_faces = true;
+    Front_Face front = Front_Face::counter_clockwise;
+};
+
+struct Cull_Stats {
+    std::size_t faces = {};
+    std::size_t back = {};
+    std::size_t outside = {};
+    std::size_t degenerate = {};   /* fewer than three vertices, never drawn */
+    std::size_t drawn = {};
+
+    std::size_t edges = {};
+    std::size_t edges_drawn = {};
+
+    [[nodiscard]] auto culled() const -> std::size_t {
+        return faces - drawn;
+    }
+};
+
+/* Faces and unique edges left after culling, indexes into the solid. Edges stay empty without an edge cache */
+struct Visible_Set {
+    std::span<std::size_t const> faces;
+    std::span<std::size_t const> edges;
+};
+
+} // namespace engine
+
+namespace engine::details {
+
+enum class Face_State : std::uint8_t {
+    drawn,
+    back,
+    outside,
+    degenerate
+};
+
+/* How the view bounds are tested, the cached box of the solid can settle them for every face at once */
+enum class View_Test {
+    per_face,
+    inside,
+    outside
+};
+
+template <class T>
+auto view_test(Solid<T> const& solid, double width, double height) -> View_Test {
+    if (!solid.bounds) {
+        return View_Test::per_face;
+    }
+
+    auto const& [ min, max ] = solid.bounds->box;
+
+    if (double(max.x) < 0 || double(max.y) < 0 || double(min.x) > width - 1 || double(min.y) > height - 1) {
+        return View_Test::outside;
+    }
+    if (double(min.x) >= 0 && double(min.y) >= 0 && double(max.x) <= width - 1 && double(max.y) <= height - 1) {
+        return View_Test::inside;
+    }
+    return View_Test::per_face;
+}
+
+template <class T>
+auto classify_face(Solid<T> const& solid, typename Solid<T>::Face_Indexer const& face, double width, double height,
+                   Cull_Options const& options, View_Test test) -> Face_State {
+    auto const& indexes = face.indexes;
+
+    if (std::size(indexes) < 3) {
+        return Face_State::degenerate;
+    }
+
+    if (test == View_Test::outside) {
+        return Face_State::outside;
+    }
+
+    auto min_x = std::numeric_limits<double>::max(), max_x = std::numeric_limits<double>::lowest();
+    auto min_y = min_x, max_y = max_x;
+    auto area = 0.0;
+
+    /* shoelace over the whole polygon, positive is clockwise on screen */
+    for (auto i = 0ul; i < std::size(indexes); ++i) {
+        auto const& current = solid.vertex()[indexes[i] - 1];
+        auto const& next = solid.vertex()[indexes[(i + 1) % std::size(indexes)] - 1];
+
+        area += double(current.x) * double(next.y) - double(next.x) * double(current.y);
+
+        min_x = std::min(min_x, double(current.x));
+        max_x = std::max(max_x, double(current.x));
+        min_y = std::min(min_y, double(current.y));
+        max_y = std::max(max_y, double(current.y));
+    }
+
+    /* view bounds, pixels are sampled at integer coordinates */
+    if (test == View_Test::per_face && (max_x < 0 || max_y < 0 || min_x > width - 1 || min_y > height - 1)) {
+        return Face_State::outside;
+    }
+
+    /* edge-on faces are kept, they still show up as lines */
+    if (options.back_faces) {
+        auto back = options.front == Front_Face::counter_clockwise ? area > 0 : area < 0;
+
+        if (back) {
+            return Face_State::back;
+        }
+    }
+
+    return Face_State::drawn;
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+/**
+ * Culling stage between the vertex transform and draw_solid.
+ * Classifies every face of an already transformed solid by screen space winding and view bounds in parallel,
+ * then compacts the survivors. A cached edge is kept while any face sharing it is drawn.
+ * When the solid has cached bounds and its box lies wholly inside or outside the view, the per face view test
+ * is skipped.
+ * The returned set points into the culler and is valid until the next cull.
+ * */
+template <class T>
+class Face_Culler {
+    std::vector<details::Face_State> m_state;
+    std::vector<std::size_t> m_order;
+    std::vector<std::size_t> m_faces;
+
+    /* edge -> faces adjacency, compressed rows */
+    std::vector<std::size_t> m_edge_offset;
+    std::vector<std::size_t> m_edge_faces;
+    std::vector<std::size_t> m_edge_order;
+    std::vector<std::size_t> m_edges;
+    std::optional<std::uint64_t> m_linked_generation;
+
+    Cull_Stats m_stats;
+
+public:
+    template <class Policy>
+    auto cull(Policy && policy, Solid<T> const& solid, std::size_t width, std::size_t height, Cull_Options const& options = {})
+            -> Visible_Set {
+        auto count = std::size(solid.faces());
+
+        if (std::size(m_order) != count) {
+            m_order.resize(count);
+            std::iota(std::begin(m_order), std::end(m_order), 0ul);
+        }
+
+        m_state.resize(count);
+        m_faces.resize(count);
+
+        auto test = details::view_test(solid, double(width), double(height));
+
+        std::transform(policy, std::cbegin(solid.faces()), std::cend(solid.faces()), std::begin(m_state),
+                       [&solid, w = double(width), h = double(height), &options, test](auto const& face) {
+                           return details::classify_face(solid, face, w, h, options, test);
+                       });
+
+        auto last = std::copy_if(policy, std::cbegin(m_order), std::cend(m_order), std::begin(m_faces),
+                                 [this](std::size_t face) { return m_state[face] == details::Face_State::drawn; });
+        m_faces.erase(last, std::end(m_faces));
+
+        auto tally = [this, &policy](details::Face_State state) -> std::size_t {
+            return std::size_t(std::count(policy, std::cbegin(m_state), std::cend(m_state), state));
+        };
+
+        m_stats = {
+            .faces = count,
+            .back = tally(details::Face_State::back),
+            .outside = tally(details::Face_State::outside),
+            .degenerate = tally(details::Face_State::degenerate),
+            .drawn = std::size(m_faces)
+        };
+
+        cull_edges(policy, solid);
+
+        return { m_faces, m_edges };
+    }
+
+    [[nodiscard]] auto stats() const -> Cull_Stats const& {
+        return m_stats;
+    }
+
+private:
+    template <class Policy>
+    auto cull_edges(Policy && policy, Solid<T> const& solid) -> void {
+        auto count = std::size(solid.edges);
+
+        if (m_linked_generation != solid.topology_generation()) {
+            link_edges(solid);
+        }
+
+        m_edges.resize(count);
+
+        auto last = std::copy_if(policy, std::cbegin(m_edge_order), std::cend(m_edge_order), std::begin(m_edges),
+                                 [this](std::size_t edge) {
+                                     return std::any_of(std::next(std::cbegin(m_edge_faces), m_edge_offset[edge]),
+                                                        std::next(std::cbegin(m_edge_faces), m_edge_offset[edge + 1]),
+                                                        [this](std::size_t face) {
+                                                            return m_state[face] == details::Face_State::drawn;
+                                                        });
+                                 });
+        m_edges.erase(last, std::end(m_edges));
+
+        m_stats.edges = count;
+        m_stats.edges_drawn = std::size(m_edges);
+    }
+
+    auto link_edges(Solid<T> const& solid) -> void {
+        struct Keyed_Edge {
+            std::size_t low, high;
+            std::size_t index;
+        };
+
+        auto by_key = [](auto const& l, auto const& r) { return std::tie(l.low, l.high) < std::tie(r.low, r.high); };
+
+        auto keyed = std::vector<Keyed_Edge>(std::size(solid.edges));
+        for (auto i = 0ul; i < std::size(solid.edges); ++i) {
+            auto [ from, to ] = solid.edges[i];
+            keyed[i] = { std::min(from, to), std::max(from, to), i };
+        }
+        std::ranges::sort(keyed, by_key);
+
+        /* the same walk as Solid::update_edges, every face edge finds its unique edge */
+        auto links = std::vector<std::pair<std::size_t, std::size_t>>{};
+
+        for (auto face = 0ul; face < std::size(solid.faces()); ++face) {
+            auto const& indexes = solid.faces()[face].indexes;
+
+            if (std::size(indexes) > 2) {
+                for (auto i = 0ul; i < std::size(indexes); ++i) {
+                    auto from = indexes[i] - 1, to = indexes[(i + 1) % std::size(indexes)] - 1;
+                    auto key = Keyed_Edge{ std::min(from, to), std::max(from, to), 0 };
+
+                    if (auto it = std::ranges::lower_bound(keyed, key, by_key);
+                        it != std::end(keyed) && it->low == key.low && it->high == key.high) {
+                        links.emplace_back(it->index, face);
+                    }
+                }
+            }
+        }
+
+        std::ranges::sort(links);
+
+        m_edge_offset.assign(std::size(solid.edges) + 1, 0ul);
+        m_edge_faces.resize(std::size(links));
+
+        for (auto i = 0ul; i < std::size(links); ++i) {
+            ++m_edge_offset[links[i].first + 1];
+            m_edge_faces[i] = links[i].second;
+        }
+        std::partial_sum(std::cbegin(m_edge_offset), std::cend(m_edge_offset), std::begin(m_edge_offset));
+
+        m_edge_order.resize(std::size(solid.edges));
+        std::iota(std::begin(m_edge_order), std::end(m_edge_order), 0ul);
+        m_linked_generation = solid.topology_generation();
+    }
+};
+
+/* Wireframe of the visible part, unique edges when the solid caches them */
+template <class T, class Edge_Fn>
+auto for_each_visible_edge(Solid<T> const& solid, Visible_Set const& visible, Edge_Fn && edge) -> void {
+    if (std::empty(solid.edges)) {
+        for (auto face : visible.faces) [[likely]] {
+            details::for_each_face_edge(solid, face, edge);
+        }
+        return;
+    }
+
+    for (auto index : visible.edges) [[likely]] {
+        auto const& [ from, to ] = solid.edges[index];
+        edge(solid.vertex()[from], solid.vertex()[to]);
+    }
+}
+
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_solid(Buffer_2D<P, C> & buffer, Solid<T> const& solid, Visible_Set const& visible, std::array<P, C> const& color) -> void {
+    for_each_visible_edge(solid, visible, [&buffer, &color](auto const& current, auto const& next) {
+        discrete_line_plot(buffer, current.x, current.y, next.x, next.y, color);
+    });
+}
+
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_solid(Tiled_Rasterizer<P, C> & raster, Solid<T> const& solid, Visible_Set const& visible, std::array<P, C> const& color) -> void {
+    for_each_visible_edge(solid, visible, [&raster, &color](auto const& current, auto const& next) {
+        raster.line(current.x, current.y, next.x, next.y, color);
+    });
+}
+
+template <class P = std::uint8_t, std::size_t C = 4, class D, class T, class Shade>
+auto draw_solid(Buffer_2D<P, C> & buffer, Depth_Buffer<D> & depth, Solid<T> const& solid, Visible_Set const& visible, Shade && shade) -> void {
+    for (auto face : visible.faces) [[likely]] {
+        details::fill_solid_face(buffer, depth, solid, face, details::face_color<P, C>(shade, face));
+    }
+}
+
+/**
+ * Filled without a depth test, visible faces are fanned through fill_triangle in face order.
+ * Only convex solids come out right, with back faces culled nothing of them overlaps.
+ * */
+template <class P = std::uint8_t, std::size_t C = 4, class T, class Shade>
+auto fill_solid(Buffer_2D<P, C> & buffer, Solid<T> const& solid, Visible_Set const& visible, Shade && shade) -> void {
+    auto flat = [&solid](std::size_t index) {
+        auto const& v = solid.vertex()[index - 1];
+        return space2D::Vector_2D<T>{ v.x, v.y };
+    };
+
+    for (auto face : visible.faces) [[likely]] {
+        auto const& indexes = solid.faces()[face].indexes;
+        auto color = details::face_color<P, C>(shade, face);
+
+        for (auto i = 1ul; i < std::size(indexes) - 1; ++i) {
+            fill_triangle(buffer, Triangle<T>{{ flat(indexes.front()), flat(indexes[i]), flat(indexes[i + 1]) }}, color);
+        }
+    }
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_RASTER_CULL_HPP
@@ -0,0 +1,269 @@
+#ifndef CPP_ENGINE_RASTER_FILL_HPP
+#define CPP_ENGINE_RASTER_FILL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../geometry/core.hpp"
+#include "../pixel-buffer.hpp"
+#include "../utility/cpu.hpp"
+#include "./triangle.hpp"
+
+namespace engine {
+
+/* Pixels evaluated per step by the half-space kernel */
+enum class Fill_Kernel {
+    scalar,
+    sse2_x4,
+    avx2_x8,
+    avx2_x16
+};
+
+} // namespace engine
+
+namespace engine::details {
+
+/* Widest kernel for this cpu, the 16 wide kernel only pays off on wide triangles */
+inline auto select_fill_kernel(long span) -> Fill_Kernel {
+    auto const& features = cpu::features();
+
+    if (features.avx2) {
+        return span >= 64 ? Fill_Kernel::avx2_x16 : Fill_Kernel::avx2_x8;
+    }
+    if (features.sse2) {
+        return Fill_Kernel::sse2_x4;
+    }
+    return Fill_Kernel::scalar;
+}
+
+/* First sample of the row that rising edges allow, everything left of it is provably uncovered */
+inline auto row_start(Triangle_Setup const& setup, long y) -> long {
+    auto start = setup.min_x;
+
+    for (auto const& e : setup.edge) {
+        if (auto w = e.at(setup.min_x, y); e.step_x() > 0 && w < 0) {
+            start = std::max(start, setup.min_x + long((-w + e.step_x() - 1) / e.step_x()));
+        }
+    }
+
+    return start;
+}
+
+/* Reference kernel, also finishes the row tails of the vector kernels */
+inline auto fill_span_scalar(Triangle_Setup const& setup, std::uint8_t * row, long x0, long x1, long y,
+                             std::uint32_t color) -> void {
+    auto const& [ e0, e1, e2 ] = setup.edge;
+    auto w0 = e0.at(x0, y), w1 = e1.at(x0, y), w2 = e2.at(x0, y);
+
+    for (auto x = x0; x <= x1; ++x) {
+        if ((w0 | w1 | w2) >= 0) {
+            std::memcpy(row + x * 4, &color, sizeof(color));
+        }
+
+        w0 += e0.step_x();
+        w1 += e1.step_x();
+        w2 += e2.step_x();
+    }
+}
+
+inline auto fill_rows_scalar(Triangle_Setup const& setup, std::uint8_t * pixels, std::size_t width,
+                             std::uint32_t color) -> void {
+    for (auto y = setup.min_y; y <= setup.max_y; ++y) {
+        fill_span_scalar(setup, pixels + y * width * 4, row_start(setup, y), setup.max_x, y, color);
+    }
+}
+
+#if defined(CPP_ENGINE_X86)
+
+CPP_ENGINE_TARGET_SSE2
+inline auto fill_rows_sse2(Triangle_Setup const& setup, std::uint8_t * pixels, std::size_t width,
+                           std::uint32_t color) -> void {
+    auto const& [ e0, e1, e2 ] = setup.edge;
+
+    /* SSE2 has no 32-bit mullo, lane offsets are built directly */
+    auto offset0 = _mm_setr_epi32(0, std::int32_t(e0.step_x()), std::int32_t(e0.step_x() * 2), std::int32_t(e0.step_x() * 3));
+    auto offset1 = _mm_setr_epi32(0, std::int32_t(e1.step_x()), std::int32_t(e1.step_x() * 2), std::int32_t(e1.step_x() * 3));
+    auto offset2 = _mm_setr_epi32(0, std::int32_t(e2.step_x()), std::int32_t(e2.step_x() * 2), std::int32_t(e2.step_x() * 3));
+
+    auto step0 = _mm_set1_epi32(std::int32_t(e0.step_x() * 4));
+    auto step1 = _mm_set1_epi32(std::int32_t(e1.step_x() * 4));
+    auto step2 = _mm_set1_epi32(std::int32_t(e2.step_x() * 4));
+
+    auto fill = _mm_set1_epi32(std::int32_t(color));
+    auto outside = _mm_set1_epi32(-1);
+
+    for (auto y = setup.min_y; y <= setup.max_y; ++y) {
+        auto row = pixels + y * width * 4;
+        auto x = row_start(setup, y);
+
+        auto w0 = _mm_add_epi32(_mm_set1_epi32(std::int32_t(e0.at(x, y))), offset0);
+        auto w1 = _mm_add_epi32(_mm_set1_epi32(std::int32_t(e1.at(x, y))), offset1);
+        auto w2 = _mm_add_epi32(_mm_set1_epi32(std::int32_t(e2.at(x, y))), offset2);
+
+        auto entered = false, done = false;
+
+        for (; x + 3 <= setup.max_x && !done; x += 4) {
+            auto mask = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(w0, w1), w2), outside);
+            auto target = reinterpret_cast<__m128i*>(row + x * 4);
+
+            if (auto bits = _mm_movemask_epi8(mask); bits == 0xFFFF) {
+                _mm_storeu_si128(target, fill);
+                entered = true;
+            } else if (bits != 0) {
+                auto old = _mm_loadu_si128(target);
+                _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(mask, fill), _mm_andnot_si128(mask, old)));
+                entered = true;
+            } else if (entered) {
+                done = true; /* convex, nothing else on this row */
+            }
+
+            w0 = _mm_add_epi32(w0, step0);
+            w1 = _mm_add_epi32(w1, step1);
+            w2 = _mm_add_epi32(w2, step2);
+        }
+
+        if (!done && x <= setup.max_x) {
+            fill_span_scalar(setup, row, x, setup.max_x, y, color);
+        }
+    }
+}
+
+template <int Registers>
+CPP_ENGINE_TARGET_AVX2
+inline auto fill_rows_avx2(Triangle_Setup const& setup, std::uint8_t * pixels, std::size_t width,
+                           std::uint32_t color) -> void {
+    constexpr auto step = 8 * Registers;
+
+    auto const& [ e0, e1, e2 ] = setup.edge;
+
+    auto lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    auto offset0 = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(std::int32_t(e0.step_x())));
+    auto offset1 = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(std::int32_t(e1.step_x())));
+    auto offset2 = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(std::int32_t(e2.step_x())));
+
+    /* distance between registers, and between steps */
+    auto lane0 = _mm256_set1_epi32(std::int32_t(e0.step_x() * 8));
+    auto lane1 = _mm256_set1_epi32(std::int32_t(e1.step_x() * 8));
+    auto lane2 = _mm256_set1_epi32(std::int32_t(e2.step_x() * 8));
+
+    auto step0 = _mm256_set1_epi32(std::int32_t(e0.step_x() * step));
+    auto step1 = _mm256_set1_epi32(std::int32_t(e1.step_x() * step));
+    auto step2 = _mm256_set1_epi32(std::int32_t(e2.step_x() * step));
+
+    auto fill = _mm256_set1_epi32(std::int32_t(color));
+    auto outside = _mm256_set1_epi32(-1);
+
+    for (auto y = setup.min_y; y <= setup.max_y; ++y) {
+        auto row = pixels + y * width * 4;
+        auto x = row_start(setup, y);
+
+        auto w0 = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(e0.at(x, y))), offset0);
+        auto w1 = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(e1.at(x, y))), offset1);
+        auto w2 = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(e2.at(x, y))), offset2);
+
+        auto entered = false, done = false;
+
+        for (; x + step - 1 <= setup.max_x && !done; x += step) {
+            auto any = false;
+
+            for (auto r = 0; r < Registers; ++r) {
+                auto v0 = r == 0 ? w0 : _mm256_add_epi32(w0, lane0);
+                auto v1 = r == 0 ? w1 : _mm256_add_epi32(w1, lane1);
+                auto v2 = r == 0 ? w2 : _mm256_add_epi32(w2, lane2);
+
+                auto mask = _mm256_cmpgt_epi32(_mm256_or_si256(_mm256_or_si256(v0, v1), v2), outside);
+                auto target = reinterpret_cast<__m256i*>(row + (x + r * 8) * 4);
+
+                if (auto bits = _mm256_movemask_epi8(mask); bits == -1) {
+                    _mm256_storeu_si256(target, fill);
+                    any = true;
+                } else if (bits != 0) {
+                    _mm256_storeu_si256(target, _mm256_blendv_epi8(_mm256_loadu_si256(target), fill, mask));
+                    any = true;
+                }
+            }
+
+            if (any) {
+                entered = true;
+            } else if (entered) {
+                done = true; /* convex, nothing else on this row */
+            }
+
+            w0 = _mm256_add_epi32(w0, step0);
+            w1 = _mm256_add_epi32(w1, step1);
+            w2 = _mm256_add_epi32(w2, step2);
+        }
+
+        if (!done && x <= setup.max_x) {
+            fill_span_scalar(setup, row, x, setup.max_x, y, color);
+        }
+    }
+}
+
+#endif
+
+} // namespace engine::details
+
+namespace engine {
+
+/**
+ * Filled triangle built on incremental half-space (edge) functions.
+ * RGBA8 buffers go through the widest kernel the cpu supports, other layouts through the scalar one.
+ * Coverage is written straight into the container, the bounding box is clipped once up front.
+ * */
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto fill_triangle(Buffer_2D<P, C> & buffer, Triangle<T> const& triangle, std::array<P, C> const& color) -> void {
+    auto const& [ v0, v1, v2 ] = triangle.vertex;
+
+    auto setup = details::setup_triangle(v0, v1, v2, buffer.width, buffer.height);
+
+    if (!setup) {
+        return;
+    }
+
+    buffer.mark_dirty({ setup->min_x, setup->min_y, setup->max_x, setup->max_y });
+
+    if constexpr (std::is_same_v<P, std::uint8_t> && C == 4) {
+        auto kernel = details::select_fill_kernel(setup->max_x - setup->min_x + 1);
+        auto word = std::bit_cast<std::uint32_t>(color);
+        auto pixels = std::data(buffer); /* byte view of the packed words */
+
+        if (kernel != Fill_Kernel::scalar && !details::fits_int32(*setup, 16)) {
+            kernel = Fill_Kernel::scalar;
+        }
+
+        switch (kernel) {
+#if defined(CPP_ENGINE_X86)
+            case Fill_Kernel::avx2_x16: details::fill_rows_avx2<2>(*setup, pixels, buffer.width, word); break;
+            case Fill_Kernel::avx2_x8:  details::fill_rows_avx2<1>(*setup, pixels, buffer.width, word); break;
+            case Fill_Kernel::sse2_x4:  details::fill_rows_sse2(*setup, pixels, buffer.width, word); break;
+#endif
+            default: details::fill_rows_scalar(*setup, pixels, buffer.width, word); break;
+        }
+    } else {
+        auto const& [ e0, e1, e2 ] = setup->edge;
+
+        for (auto y = setup->min_y; y <= setup->max_y; ++y) {
+            auto w0 = e0.at(setup->min_x, y), w1 = e1.at(setup->min_x, y), w2 = e2.at(setup->min_x, y);
+
+            for (auto x = setup->min_x; x <= setup->max_x; ++x) {
+                if ((w0 | w1 | w2) >= 0) {
+                    std::ranges::copy(color, std::next(std::begin(buffer.container), flat_index(x, y, buffer.width, C)));
+                }
+
+                w0 += e0.step_x();
+                w1 += e1.step_x();
+                w2 += e2.step_x();
+            }
+        }
+    }
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_RASTER_FILL_HPP
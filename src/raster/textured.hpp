@@ -0,0 +1,249 @@
+#ifndef CPP_ENGINE_RASTER_TEXTURED_HPP
+#define CPP_ENGINE_RASTER_TEXTURED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "../pixel-buffer.hpp"
+#include "../depth-buffer.hpp"
+#include "../texture/sampler.hpp"
+#include "../utility/cpu.hpp"
+#include "./triangle.hpp"
+
+namespace engine {
+
+/* Screen position and depth after the perspective divide, w before it (1 without perspective) */
+struct Textured_Vertex {
+    double x, y, z;
+    double w;
+    double u, v;
+};
+
+/* Face of an indexed mesh, 0 based, same layout as md2::Mesh */
+struct Textured_Face {
+    std::array<std::uint32_t, 3> vec_index;
+    std::array<std::uint32_t, 3> tex_index;
+};
+
+} // namespace engine
+
+namespace engine::details {
+
+/* 1/w, u/w and v/w are linear in screen space, u and v are recovered per pixel with one reciprocal */
+struct Textured_Setup {
+    Triangle_Setup triangle;
+    Attribute_Plane q, uq, vq, z;
+};
+
+/* Plane values at the first lane of a tile row, lane i adds i times the x step */
+struct Textured_Row {
+    float q, uq, vq, z;
+    float dq, duq, dvq, dz;
+};
+
+inline auto textured_row(Textured_Setup const& setup, long x0, long y) -> Textured_Row {
+    return {
+        float(setup.q.at(x0, y)), float(setup.uq.at(x0, y)), float(setup.vq.at(x0, y)), float(setup.z.at(x0, y)),
+        float(setup.q.dx), float(setup.uq.dx), float(setup.vq.dx), float(setup.z.dx)
+    };
+}
+
+/* Pixels [first, last] of the tile row starting at x0, returns the closest depth written */
+inline auto textured_row_scalar(Textured_Setup const& setup, long x0, long y, long first, long last,
+                                Texture_View const& texture, Sampling sampling,
+                                float * depth_row, std::uint32_t * pixel_row) -> float {
+    auto const& [ e0, e1, e2 ] = setup.triangle.edge;
+    auto row = textured_row(setup, x0, y);
+    auto closest = std::numeric_limits<float>::max();
+
+    auto w0 = e0.at(first, y), w1 = e1.at(first, y), w2 = e2.at(first, y);
+
+    for (auto x = first; x <= last; ++x, w0 += e0.step_x(), w1 += e1.step_x(), w2 += e2.step_x()) {
+        if ((w0 | w1 | w2) < 0) {
+            continue;
+        }
+
+        auto lane = float(x - x0);
+        auto z = row.z + lane * row.dz;
+
+        if (!(z < depth_row[x])) {
+            continue;
+        }
+
+        auto r = 1.0f / (row.q + lane * row.dq);
+        auto u = (row.uq + lane * row.duq) * r;
+        auto v = (row.vq + lane * row.dvq) * r;
+
+        depth_row[x] = z;
+        pixel_row[x] = sample(texture, sampling, u, v);
+        closest = std::min(closest, z);
+    }
+
+    return closest;
+}
+
+#if defined(CPP_ENGINE_X86)
+
+/* One depth tile row is one register, depth test, reciprocal and gathers run on all eight lanes */
+CPP_ENGINE_TARGET_AVX2
+inline auto textured_row_avx2(Textured_Setup const& setup, long x0, long y, long first, long last,
+                              Texture_View const& texture, Sampling sampling,
+                              float * depth_row, std::uint32_t * pixel_row) -> float {
+    auto const& [ e0, e1, e2 ] = setup.triangle.edge;
+    auto row = textured_row(setup, x0, y);
+
+    auto index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    auto lanes = _mm256_cvtepi32_ps(index);
+    auto x = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(x0)), index);
+
+    auto edge = [&index, x0, y](Edge_Function const& e) CPP_ENGINE_TARGET_AVX2 {
+        return _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(e.at(x0, y))),
+                                _mm256_mullo_epi32(index, _mm256_set1_epi32(std::int32_t(e.step_x()))));
+    };
+
+    auto inside = _mm256_and_si256(_mm256_cmpgt_epi32(x, _mm256_set1_epi32(std::int32_t(first - 1))),
+                                   _mm256_cmpgt_epi32(_mm256_set1_epi32(std::int32_t(last + 1)), x));
+    auto covered = _mm256_cmpgt_epi32(_mm256_or_si256(_mm256_or_si256(edge(e0), edge(e1)), edge(e2)), _mm256_set1_epi32(-1));
+    auto mask = _mm256_and_si256(inside, covered);
+
+    auto none = std::numeric_limits<float>::max();
+
+    if (_mm256_testz_si256(mask, mask)) {
+        return none;
+    }
+
+    auto z = _mm256_add_ps(_mm256_set1_ps(row.z), _mm256_mul_ps(lanes, _mm256_set1_ps(row.dz)));
+    auto stored = _mm256_maskload_ps(depth_row + x0, mask); /* masked lanes never fault past the row end */
+    auto pass = _mm256_and_si256(mask, _mm256_castps_si256(_mm256_cmp_ps(z, stored, _CMP_LT_OQ)));
+
+    if (_mm256_testz_si256(pass, pass)) {
+        return none;
+    }
+
+    auto r = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(_mm256_set1_ps(row.q), _mm256_mul_ps(lanes, _mm256_set1_ps(row.dq))));
+    auto u = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(row.uq), _mm256_mul_ps(lanes, _mm256_set1_ps(row.duq))), r);
+    auto v = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(row.vq), _mm256_mul_ps(lanes, _mm256_set1_ps(row.dvq))), r);
+
+    auto texel = sampling == Sampling::nearest ? sample_nearest_x8(texture, u, v, pass)
+                                               : sample_bilinear_x8(texture, u, v, pass);
+
+    _mm256_maskstore_ps(depth_row + x0, pass, z);
+    _mm256_maskstore_epi32(reinterpret_cast<int *>(pixel_row + x0), pass, texel);
+
+    /* horizontal min over the written lanes */
+    auto m = _mm256_blendv_ps(_mm256_set1_ps(none), z, _mm256_castsi256_ps(pass));
+    m = _mm256_min_ps(m, _mm256_permute2f128_ps(m, m, 1));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm256_cvtss_f32(m);
+}
+
+#endif
+
+} // namespace engine::details
+
+namespace engine {
+
+/**
+ * Textured, z-tested triangle with perspective correct texture coordinates.
+ * Walks the depth tiles it covers so occluded tiles are skipped and every tile row fits one AVX2 register.
+ * Vertices behind the eye (w <= 0) must be clipped beforehand, such triangles are dropped.
+ * */
+inline auto draw_textured_triangle(Basic_RGBA_Buffer & buffer, Depth_Buffer<float> & depth,
+                                   std::array<Textured_Vertex, 3> const& vertex, Texture_View const& texture,
+                                   Sampling sampling = Sampling::bilinear) -> void {
+    auto const& [ v0, v1, v2 ] = vertex;
+
+    if (v0.w <= 0 || v1.w <= 0 || v2.w <= 0 || texture.width <= 0 || texture.height <= 0) {
+        return;
+    }
+
+    auto triangle = details::setup_triangle(v0, v1, v2, buffer.width, buffer.height);
+
+    if (!triangle) {
+        return;
+    }
+
+    buffer.mark_dirty({ triangle->min_x, triangle->min_y, triangle->max_x, triangle->max_y });
+
+    auto q0 = 1 / v0.w, q1 = 1 / v1.w, q2 = 1 / v2.w;
+
+    auto setup = details::Textured_Setup{
+        .triangle = *triangle,
+        .q = details::make_plane(*triangle, q0, q1, q2),
+        .uq = details::make_plane(*triangle, v0.u * q0, v1.u * q1, v2.u * q2),
+        .vq = details::make_plane(*triangle, v0.v * q0, v1.v * q1, v2.v * q2),
+        .z = details::make_plane(*triangle, v0.z, v1.z, v2.z)
+    };
+
+    constexpr auto tile_size = long(Depth_Buffer<float>::tile_size);
+
+    auto vector = cpu::features().avx2 && details::fits_int32(*triangle, tile_size);
+    auto z_min = float(std::min({ v0.z, v1.z, v2.z }));
+
+    for (auto ty = triangle->min_y / tile_size; ty <= triangle->max_y / tile_size; ++ty) {
+        for (auto tx = triangle->min_x / tile_size; tx <= triangle->max_x / tile_size; ++tx) {
+            auto tile = ty * depth.columns + tx;
+
+            /* hierarchical rejection */
+            if (depth.occluded(tile, z_min)) {
+                continue;
+            }
+
+            auto x0 = tx * tile_size;
+            auto first = std::max(x0, triangle->min_x), last = std::min(x0 + tile_size - 1, triangle->max_x);
+            auto y0 = std::max(ty * tile_size, triangle->min_y), y1 = std::min(ty * tile_size + tile_size - 1, triangle->max_y);
+
+            auto closest = Depth_Buffer<float>::far;
+
+            for (auto y = y0; y <= y1; ++y) {
+                auto depth_row = std::data(depth.container) + y * depth.width;
+                auto pixel_row = std::data(buffer.container) + y * buffer.width;
+
+#if defined(CPP_ENGINE_X86)
+                auto written = vector
+                    ? details::textured_row_avx2(setup, x0, y, first, last, texture, sampling, depth_row, pixel_row)
+                    : details::textured_row_scalar(setup, x0, y, first, last, texture, sampling, depth_row, pixel_row);
+#else
+                auto written = details::textured_row_scalar(setup, x0, y, first, last, texture, sampling, depth_row, pixel_row);
+#endif
+                closest = std::min(closest, written);
+            }
+
+            if (closest != Depth_Buffer<float>::far) {
+                depth.touch(tile, closest);
+            }
+        }
+    }
+}
+
+/**
+ * Indexed mesh already in screen space. w holds the per vertex clip w and may be empty without perspective.
+ * Faces need vec_index and tex_index triples, md2::Mesh and Textured_Face both fit.
+ * */
+template <class Positions, class W, class Uvs, class Faces>
+auto draw_textured_mesh(Basic_RGBA_Buffer & buffer, Depth_Buffer<float> & depth, Positions const& position, W const& w,
+                        Uvs const& uv, Faces const& faces, Texture_View const& texture,
+                        Sampling sampling = Sampling::bilinear) -> void {
+    for (auto const& face : faces) {
+        auto corner = [&](std::size_t k) -> Textured_Vertex {
+            auto const& p = position[face.vec_index[k]];
+            auto const& t = uv[face.tex_index[k]];
+
+            return {
+                double(p.x), double(p.y), double(p.z),
+                std::empty(w) ? 1.0 : double(w[face.vec_index[k]]),
+                double(t.x), double(t.y)
+            };
+        };
+
+        draw_textured_triangle(buffer, depth, { corner(0), corner(1), corner(2) }, texture, sampling);
+    }
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_RASTER_TEXTURED_HPP
@@ -0,0 +1,165 @@
+#ifndef CPP_ENGINE_RASTER_TILED_HPP
+#define CPP_ENGINE_RASTER_TILED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <vector>
+
+#include "../geometry/core.hpp"
+#include "../pixel-buffer.hpp"
+#include "../draw.hpp"
+
+namespace engine {
+
+using Tile_Rect = Clip_Rect;
+
+/**
+ * Deferred rasterizer that splits the screen in square tiles.
+ * Primitives are binned per tile on submission and every tile is rasterized in parallel on flush.
+ * Tiles own disjoint pixels and keep submission order, so the output matches the serial path.
+ * */
+template <class P = std::uint8_t, std::size_t C = 4>
+class Tiled_Rasterizer {
+public:
+    struct Line {
+        long x1, y1;
+        long x2, y2;
+        std::array<P, C> color;
+    };
+
+private:
+    std::size_t m_width;
+    std::size_t m_height;
+    std::size_t m_tile_size;
+    std::size_t m_columns;
+    std::size_t m_rows;
+
+    std::vector<Line> m_lines;
+    std::vector<std::vector<std::uint32_t>> m_bins;
+    std::vector<std::size_t> m_tiles;
+
+public:
+    Tiled_Rasterizer(std::size_t width, std::size_t height, std::size_t tile_size = 64) :
+        m_width(width),
+        m_height(height),
+        m_tile_size(tile_size),
+        m_columns((width + tile_size - 1) / tile_size),
+        m_rows((height + tile_size - 1) / tile_size),
+        m_lines(),
+        m_bins(m_columns * m_rows),
+        m_tiles(m_columns * m_rows)
+    {
+        std::iota(std::begin(m_tiles), std::end(m_tiles), 0ul);
+    }
+
+    template <class T>
+    auto line(T x0, T y0, T xn, T yn, std::array<P, C> const& color) -> void {
+        auto in_range = [](auto c) { return std::abs(double(c)) < details::max_line_coordinate; };
+
+        if (!in_range(x0) || !in_range(y0) || !in_range(xn) || !in_range(yn)) {
+            return; /* same rule as discrete_line_plot */
+        }
+
+        auto primitive = Line{ std::lround(x0), std::lround(y0), std::lround(xn), std::lround(yn), color };
+
+        auto min_x = std::max(std::min(primitive.x1, primitive.x2), 0l);
+        auto min_y = std::max(std::min(primitive.y1, primitive.y2), 0l);
+        auto max_x = std::min(std::max(primitive.x1, primitive.x2), long(m_width) - 1);
+        auto max_y = std::min(std::max(primitive.y1, primitive.y2), long(m_height) - 1);
+
+        if (min_x > max_x || min_y > max_y) {
+            return; /* entirely off-screen */
+        }
+
+        auto id = static_cast<std::uint32_t>(std::size(m_lines));
+        m_lines.push_back(primitive);
+
+        for (auto row = min_y / long(m_tile_size); row <= max_y / long(m_tile_size); ++row) {
+            for (auto column = min_x / long(m_tile_size); column <= max_x / long(m_tile_size); ++column) {
+                if (crosses(primitive, tile_rect(column, row))) {
+                    m_bins[row * m_columns + column].push_back(id);
+                }
+            }
+        }
+    }
+
+    template <class T>
+    auto line(Vector_2D<T> origin, Vector_2D<T> target, std::array<P, C> const& color) -> void {
+        line(origin.x, origin.y, target.x, target.y, color);
+    }
+
+    /* Rasterize every binned primitive into buffer and reset the bins */
+    auto flush(Buffer_2D<P, C> & buffer) -> void {
+        /* marked up front, the mask is shared between tiles */
+        for (auto tile : m_tiles) {
+            if (!std::empty(m_bins[tile])) {
+                buffer.mark_dirty(tile_rect(tile % m_columns, tile / m_columns));
+            }
+        }
+
+        std::for_each(std::execution::par, std::cbegin(m_tiles), std::cend(m_tiles), [this, &buffer](auto tile) {
+            auto rect = tile_rect(tile % m_columns, tile / m_columns);
+
+            for (auto id : m_bins[tile]) {
+                auto const& line = m_lines[id];
+
+                /* only the steps inside the tile are walked, tiles never straddle the buffer edge */
+                details::clipped_line_walk(line.x1, line.y1, line.x2, line.y2, rect, [&buffer, &line](auto x, auto y) {
+                    buffer.set_unchecked(x, y, line.color);
+                    return true;
+                });
+            }
+        });
+
+        clear();
+    }
+
+    auto clear() -> void {
+        m_lines.clear();
+        std::ranges::for_each(m_bins, [](auto & bin) { bin.clear(); });
+    }
+
+    [[nodiscard]] auto tile_size() const noexcept -> std::size_t {
+        return m_tile_size;
+    }
+
+private:
+    auto tile_rect(std::size_t column, std::size_t row) const -> Tile_Rect {
+        auto x0 = long(column * m_tile_size), y0 = long(row * m_tile_size);
+        return {
+            x0, y0,
+            std::min(x0 + long(m_tile_size), long(m_width)) - 1,
+            std::min(y0 + long(m_tile_size), long(m_height)) - 1
+        };
+    }
+
+    /* Conservative test, the walk strays less than a pixel away from the ideal segment */
+    static auto crosses(Line const& line, Tile_Rect rect) -> bool {
+        auto side = [&line](long x, long y) -> std::int64_t {
+            return std::int64_t(line.y2 - line.y1) * (x - line.x1) - std::int64_t(line.x2 - line.x1) * (y - line.y1);
+        };
+
+        auto corners = std::array{
+            side(rect.x0 - 1, rect.y0 - 1), side(rect.x1 + 1, rect.y0 - 1),
+            side(rect.x0 - 1, rect.y1 + 1), side(rect.x1 + 1, rect.y1 + 1)
+        };
+
+        return std::ranges::any_of(corners, [](auto s) { return s >= 0; })
+            && std::ranges::any_of(corners, [](auto s) { return s <= 0; });
+    }
+};
+
+template <class P = std::uint8_t, std::size_t C = 4, class T>
+auto draw_solid(Tiled_Rasterizer<P, C> & raster, Solid<T> const& solid, std::array<P, C> const& color) -> void {
+    details::for_each_solid_edge(solid, [&raster, &color](auto const& current, auto const& next) {
+        raster.line(current.x, current.y, next.x, next.y, color);
+    });
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_RASTER_TILED_HPP
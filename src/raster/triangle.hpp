@@ -0,0 +1,307 @@
+#ifndef CPP_ENGINE_RASTER_TRIANGLE_HPP
+#define CPP_ENGINE_RASTER_TRIANGLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "../geometry/core.hpp"
+#include "../pixel-buffer.hpp"
+#include "../depth-buffer.hpp"
+
+namespace engine::details {
+
+/* Vertices are snapped to 1/16 of a pixel, pixels are sampled at integer coordinates like the line plots */
+inline constexpr auto subpixel_bits = 4;
+inline constexpr auto subpixel_one = std::int64_t{1} << subpixel_bits;
+
+/* Beyond this the fixed point products may overflow, such triangles are dropped */
+inline constexpr auto max_coordinate = double(1 << 24);
+
+/* E(x, y) = a * X + b * Y + c, with X and Y in subpixel units */
+struct Edge_Function {
+    std::int64_t a, b, c;
+
+    [[nodiscard]] constexpr auto at(long x, long y) const noexcept -> std::int64_t {
+        return a * (x * subpixel_one) + b * (y * subpixel_one) + c;
+    }
+
+    [[nodiscard]] constexpr auto step_x() const noexcept -> std::int64_t {
+        return a * subpixel_one;
+    }
+
+    [[nodiscard]] constexpr auto step_y() const noexcept -> std::int64_t {
+        return b * subpixel_one;
+    }
+};
+
+struct Triangle_Setup {
+    /* edge[i] is opposite to vertex i, positive inside, top-left rule folded into c */
+    std::array<Edge_Function, 3> edge;
+    std::array<std::int64_t, 3> x, y;
+
+    /* pixel bounding box, already clipped to the target */
+    long min_x, min_y;
+    long max_x, max_y;
+};
+
+template <class V>
+auto setup_triangle(V const& v0, V const& v1, V const& v2, std::size_t width, std::size_t height)
+        -> std::optional<Triangle_Setup> {
+    auto in_range = [](auto const& v) {
+        return std::abs(v.x) < max_coordinate && std::abs(v.y) < max_coordinate;
+    };
+
+    if (!in_range(v0) || !in_range(v1) || !in_range(v2)) {
+        return std::nullopt;
+    }
+
+    auto snap = [](auto c) { return std::int64_t(std::llround(double(c) * subpixel_one)); };
+
+    auto setup = Triangle_Setup{
+        .x = { snap(v0.x), snap(v1.x), snap(v2.x) },
+        .y = { snap(v0.y), snap(v1.y), snap(v2.y) }
+    };
+
+    auto const& x = setup.x;
+    auto const& y = setup.y;
+
+    auto make_edge = [&x, &y](std::size_t from, std::size_t to) -> Edge_Function {
+        auto a = y[from] - y[to];
+        auto b = x[to] - x[from];
+        return { a, b, -(a * x[from] + b * y[from]) };
+    };
+
+    setup.edge = { make_edge(1, 2), make_edge(2, 0), make_edge(0, 1) };
+
+    auto area = setup.edge[0].a * x[0] + setup.edge[0].b * y[0] + setup.edge[0].c;
+
+    if (area == 0) {
+        return std::nullopt;
+    }
+
+    for (auto & e : setup.edge) {
+        if (area < 0) {
+            e = { -e.a, -e.b, -e.c };
+        }
+
+        /* top-left rule, only top and left edges own the samples lying on them */
+        if (auto top_left = e.a > 0 || (e.a == 0 && e.b > 0); !top_left) {
+            e.c -= 1;
+        }
+    }
+
+    /* first and last sample covered by the snapped bounds */
+    auto ceil_div = [](std::int64_t v) { return long(-((-v) >> subpixel_bits)); };
+    auto floor_div = [](std::int64_t v) { return long(v >> subpixel_bits); };
+
+    setup.min_x = std::max(ceil_div(std::min({ x[0], x[1], x[2] })), 0l);
+    setup.min_y = std::max(ceil_div(std::min({ y[0], y[1], y[2] })), 0l);
+    setup.max_x = std::min(floor_div(std::max({ x[0], x[1], x[2] })), long(width) - 1);
+    setup.max_y = std::min(floor_div(std::max({ y[0], y[1], y[2] })), long(height) - 1);
+
+    if (setup.min_x > setup.max_x || setup.min_y > setup.max_y) {
+        return std::nullopt;
+    }
+
+    return setup;
+}
+
+/* Int32 lanes are exact when every edge value reachable by a step fits, extremes lie on the corners */
+inline auto fits_int32(Triangle_Setup const& setup, long overshoot) -> bool {
+    constexpr auto limit = std::int64_t{ std::numeric_limits<std::int32_t>::max() } / 2;
+
+    return std::ranges::all_of(setup.edge, [&setup, overshoot, limit](auto const& e) {
+        auto corners = std::array{
+            e.at(setup.min_x, setup.min_y), e.at(setup.max_x + overshoot, setup.min_y),
+            e.at(setup.min_x, setup.max_y), e.at(setup.max_x + overshoot, setup.max_y)
+        };
+        return std::ranges::all_of(corners, [limit](auto v) { return v > -limit && v < limit; })
+            && std::abs(e.step_x()) * 16 < limit;
+    });
+}
+
+/* Linear attribute plane over pixel coordinates, z(x, y) = origin + dx * x + dy * y */
+struct Attribute_Plane {
+    double origin, dx, dy;
+
+    [[nodiscard]] constexpr auto at(long x, long y) const noexcept -> double {
+        return origin + dx * double(x) + dy * double(y);
+    }
+};
+
+inline auto make_plane(Triangle_Setup const& setup, double a0, double a1, double a2) -> Attribute_Plane {
+    auto const& x = setup.x;
+    auto const& y = setup.y;
+    auto scale = double(subpixel_one);
+
+    auto x1 = (x[1] - x[0]) / scale, y1 = (y[1] - y[0]) / scale;
+    auto x2 = (x[2] - x[0]) / scale, y2 = (y[2] - y[0]) / scale;
+    auto det = x1 * y2 - x2 * y1;
+
+    auto dx = ((a1 - a0) * y2 - (a2 - a0) * y1) / det;
+    auto dy = ((a2 - a0) * x1 - (a1 - a0) * x2) / det;
+
+    return { a0 - dx * (x[0] / scale) - dy * (y[0] / scale), dx, dy };
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+/* Filled, z-tested triangle, occluded pixels are rejected before the color write */
+template <class P = std::uint8_t, std::size_t C = 4, class D, class T>
+auto draw_triangle(Buffer_2D<P, C> & buffer, Depth_Buffer<D> & depth, Triangle_3D<T> const& triangle,
+                   std::array<P, C> const& color) -> void {
+    auto const& [ v0, v1, v2 ] = triangle.vertex;
+
+    auto setup = details::setup_triangle(v0, v1, v2, buffer.width, buffer.height);
+
+    if (!setup) {
+        return;
+    }
+
+    buffer.mark_dirty({ setup->min_x, setup->min_y, setup->max_x, setup->max_y });
+
+    auto const& [ e0, e1, e2 ] = setup->edge;
+    auto plane = details::make_plane(*setup, v0.z, v1.z, v2.z);
+
+    auto z_min = D(std::min({ v0.z, v1.z, v2.z }));
+    auto z_max = D(std::max({ v0.z, v1.z, v2.z }));
+
+    constexpr auto tile_size = long(Depth_Buffer<D>::tile_size);
+
+    for (auto ty = setup->min_y / tile_size; ty <= setup->max_y / tile_size; ++ty) {
+        for (auto tx = setup->min_x / tile_size; tx <= setup->max_x / tile_size; ++tx) {
+            auto tile = ty * depth.columns + tx;
+
+            /* hierarchical rejection */
+            if (depth.occluded(tile, z_min)) {
+                continue;
+            }
+
+            auto trivially_visible = depth.visible(tile, z_max);
+            auto closest = Depth_Buffer<D>::far;
+
+            auto x0 = std::max(tx * tile_size, setup->min_x), x1 = std::min(tx * tile_size + tile_size - 1, setup->max_x);
+            auto y0 = std::max(ty * tile_size, setup->min_y), y1 = std::min(ty * tile_size + tile_size - 1, setup->max_y);
+
+            for (auto y = y0; y <= y1; ++y) {
+                auto w0 = e0.at(x0, y), w1 = e1.at(x0, y), w2 = e2.at(x0, y);
+
+                for (auto x = x0; x <= x1; ++x) {
+                    if ((w0 | w1 | w2) >= 0) {
+                        auto z = D(plane.at(x, y));
+
+                        auto passed = trivially_visible;
+
+                        if (passed) {
+                            depth.set(x, y, z);
+                        } else {
+                            passed = depth.test_and_set(x, y, z);
+                        }
+
+                        if (passed) {
+                            buffer.set_unchecked(x, y, color);
+                            closest = std::min(closest, z);
+                        }
+                    }
+
+                    w0 += e0.step_x();
+                    w1 += e1.step_x();
+                    w2 += e2.step_x();
+                }
+            }
+
+            if (closest != Depth_Buffer<D>::far) {
+                depth.touch(tile, closest);
+            }
+        }
+    }
+}
+
+/* Gray level from the face normal facing the viewer, degenerate faces get the level of an edge-on one */
+template <class T>
+auto flat_shade(Solid<T> const& solid, std::size_t face) -> std::array<std::uint8_t, 4> {
+    auto const& indexes = solid.faces()[face].indexes;
+    auto const& a = solid.vertex()[indexes[0] - 1];
+    auto const& b = solid.vertex()[indexes[1] - 1];
+    auto const& c = solid.vertex()[indexes[2] - 1];
+
+    auto u = b - a, v = c - a;
+    auto normal = normalize(Vector_3D<T>{ u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x });
+    auto facing = std::isfinite(normal.z) ? std::min(std::abs(normal.z), T(1)) : T(0);
+    auto level = static_cast<std::uint8_t>(40 + 200 * facing);
+
+    return { level, level, level, 255 };
+}
+
+/* Clip space triangle, clipped against the near plane and the guard band, the remaining polygon is fanned */
+template <class P = std::uint8_t, std::size_t C = 4, class D, class T>
+auto draw_triangle(Buffer_2D<P, C> & buffer, Depth_Buffer<D> & depth, std::array<Vector_4D<T>, 3> const& triangle,
+                   std::array<P, C> const& color, Clip_Volume const& volume = {}) -> void {
+    auto polygon = clip_triangle(triangle[0], triangle[1], triangle[2], volume);
+
+    if (polygon.count == 0) {
+        return;
+    }
+
+    auto first = perspective_divide(polygon.vertex[0]);
+    auto previous = perspective_divide(polygon.vertex[1]);
+
+    for (auto i = 2ul; i < polygon.count; ++i) {
+        auto current = perspective_divide(polygon.vertex[i]);
+        draw_triangle(buffer, depth, Triangle_3D<T>{{ first, previous, current }}, color);
+        previous = current;
+    }
+}
+
+} // namespace engine
+
+namespace engine::details {
+
+/* Fans one face into triangles */
+template <class P = std::uint8_t, std::size_t C = 4, class D, class T>
+auto fill_solid_face(Buffer_2D<P, C> & buffer, Depth_Buffer<D> & depth, Solid<T> const& solid, std::size_t face,
+                     std::array<P, C> const& color) -> void {
+    auto const& indexes = solid.faces()[face].indexes;
+    auto const& first = solid.vertex()[indexes.front() - 1];
+
+    for (auto i = 1ul; i < std::size(indexes) - 1; ++i) {
+        draw_triangle(buffer, depth, Triangle_3D<T>{{
+            first, solid.vertex()[indexes[i] - 1], solid.vertex()[indexes[i + 1] - 1]
+        }}, color);
+    }
+}
+
+/* Shade is a color or a face -> color callable */
+template <class P, std::size_t C, class Shade>
+auto face_color(Shade & shade, std::size_t face) -> std::array<P, C> {
+    if constexpr (std::invocable<Shade &, std::size_t>) {
+        return shade(face);
+    } else {
+        return shade;
+    }
+}
+
+} // namespace engine::details
+
+namespace engine {
+
+/* Filled, z-tested solid, faces are fanned into triangles. Shade is a color or a face -> color callable */
+template <class P = std::uint8_t, std::size_t C = 4, class D, class T, class Shade>
+auto draw_solid(Buffer_2D<P, C> & buffer, Depth_Buffer<D> & depth, Solid<T> const& solid, Shade && shade) -> void {
+    for (auto face = 0ul; face < std::size(solid.faces()); ++face) [[likely]] {
+        if (std::size(solid.faces()[face].indexes) > 2) {
+            details::fill_solid_face(buffer, depth, solid, face, details::face_color<P, C>(shade, face));
+        }
+    }
+}
+
+} // namespace engine
+
+#endif //CPP_ENGINE_RASTER_TRIANGLE_HPP
@@ -15,17 +15,20 @@
 namespace engine {
 
 class Entity_Owner : public Entity_Base {
+    /* Turn rate about y in radians per second, the rate the former glRotatef angle grew at in degrees */
+    static constexpr auto spin = Vector_3Df{ 0.0f, 15.0f * 60.0f * std::numbers::pi_v<float> / 180.0f * std::numbers::pi_v<float> / 180.0f, 0.0f };
+
 public:
     using Entity_Ptr = std::shared_ptr<Buffered_Entity_Base>;
 
     Entity_Ptr m_model;
     Vector_3Df m_position;
-    float m_angle;
+    Quaternionf m_orientation;
 
     explicit Entity_Owner(Entity_Ptr model, Vector_3Df position) :
      m_model(std::move(model)),
      m_position(std::move(position)),
-     m_angle()
+     m_orientation()
     {}
 
     auto render() -> void override {
@@ -35,7 +38,10 @@ public:
         glLoadIdentity();
         glTranslatef(m_position.x, m_position.y, m_position.z);
         glScalef(0.005f, 0.005f, 0.005f);
-        glRotatef(m_angle, 0.0f, 1.0f, 0.0f);
+
+        auto orientation = Basic_Mat4<float, Column_Major>(m_orientation);
+        glMultMatrixf(std::data(orientation.container[0]));
+
         glColor3f(1.0f, 0.0f, 0.0f);
 
         m_model->render();
@@ -43,8 +49,10 @@ public:
         glPopMatrix();
     }
 
+    /* Integrated in place, no angle to rebuild from. The model updates too, a streamed one uploads its batches */
     auto update(float seconds) -> void override {
-        m_angle += 15.0f * seconds * std::numbers::pi_v<float> / 180.0f * 60.0f;
+        m_orientation = integrate(m_orientation, spin, seconds);
+        m_model->update(seconds);
     }
 
     ~Entity_Owner() override = default;
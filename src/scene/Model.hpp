@@ -1,8 +1,11 @@
 #ifndef CPP_ENGINE_MODEL_HPP
 #define CPP_ENGINE_MODEL_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <numbers>
+#include <span>
 #include <vector>
 #include <utility>
 
@@ -12,6 +15,7 @@
 
 #include "./Buffered_Entity_Base.hpp"
 #include "../geometry/core.hpp"
+#include "../io/mesh_cache.hpp"
 
 namespace engine {
 
@@ -20,81 +24,146 @@ protected:
     /* vertex & index handle, dont use color */
     std::array<std::uint32_t, 2> m_vbo_handles;
 
-    /* 3d m_solid data */
-    std::uint32_t m_vertex_count;
-    std::uint32_t m_indexes_count;
-    std::vector<float> m_vertex;
-    std::vector<std::uint16_t> m_indexes;
+    /* bytes in use and allocated per buffer, appended batches go after the used bytes */
+    std::array<std::size_t, 2> m_used;
+    std::array<std::size_t, 2> m_capacity;
+
+    /* triangulated m_solid data, released once it is on the gpu */
+    io::Mesh m_mesh;
+    std::size_t m_indexes_count;
+    GLenum m_index_type;
+
+    /* interleaved layout, x y z [u v] [nx ny nz] */
+    GLsizei m_stride;
+    std::uint32_t m_attributes;
 
 public:
     Model(Solid<float> const& solid) :
+     Model(io::Mesh::from_solid(solid))
+    {}
+
+    /* From a mesh cache the buffers upload straight from the mapped file */
+    Model(io::Mesh mesh) :
      m_vbo_handles(),
-     m_vertex_count(std::size(solid.vertex)),
-     m_indexes_count(),
-     m_vertex(m_vertex_count * 3),  // vertex count * (x y z)
-     m_indexes() // indexes count * quad
-    {
-        /* Copy contiguous vertex vector */
-        std::memcpy(std::data(m_vertex), std::data(solid.vertex), sizeof(float) * 3 * m_vertex_count);
-
-        /* Copy non-contiguous indexes vector as triangles */
-        for (auto i = 0ul; i < std::size(solid.faces); ++i) {
-            if (auto length = std::size(solid.faces[i].indexes); length == 3) { // a triangle
-                m_indexes_count += 1;
-
-                // push 0-1-2
-                m_indexes.push_back(solid.faces[i].indexes[0] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[1] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[2] - 1);
-            }
-            else if (length == 4) { // a quad
-                m_indexes_count += 2;
-
-                // push 0-1-2
-                m_indexes.push_back(solid.faces[i].indexes[0] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[1] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[2] - 1);
-
-                // push 0-2-3
-                m_indexes.push_back(solid.faces[i].indexes[0] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[2] - 1);
-                m_indexes.push_back(solid.faces[i].indexes[3] - 1);
-            }
-        }
-    }
+     m_used(),
+     m_capacity(),
+     m_mesh(std::move(mesh)),
+     m_indexes_count(m_mesh.index_count()),
+     m_index_type(m_mesh.index_size() == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT),
+     m_stride(static_cast<GLsizei>(m_mesh.vertex_stride())),
+     m_attributes(m_mesh.attributes())
+    {}
 
     auto load() -> void override {
+        auto vertex = m_mesh.vertex_data();
+        auto indexes = m_mesh.index_data();
+
         glGenBuffers(2, std::data(m_vbo_handles));
 
         /* vertex */
         glBindBuffer(GL_ARRAY_BUFFER, m_vbo_handles[0]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * std::size(m_vertex),
-                                                std::data(m_vertex), GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, std::size(vertex), std::data(vertex), GL_STATIC_DRAW);
 
         /* indexes */
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vbo_handles[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint16_t) * std::size(m_indexes),
-                                                std::data(m_indexes), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, std::size(indexes), std::data(indexes), GL_STATIC_DRAW);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        m_used = m_capacity = { std::size(vertex), std::size(indexes) };
+        m_mesh = {};
     };
 
+    /**
+     * Appends a batch after what is on the GPU, its indexes count from the model's first vertex. Buffers double
+     * when full and are copied on the GPU, so a mesh fed a batch at a time is never held on the CPU.
+     * Appending needs uint32 indexes and the same layout throughout, an empty model takes the batch's.
+     * */
+    auto append(io::Interleaved_Mesh const& batch) -> void {
+        if (m_indexes_count == 0 && m_used[0] == 0) {
+            m_index_type = GL_UNSIGNED_INT;
+            m_stride = static_cast<GLsizei>(batch.stride());
+            m_attributes = batch.attributes;
+        }
+
+        if (m_index_type != GL_UNSIGNED_INT || batch.attributes != m_attributes) {
+            fmt::print("Err(batch does not match the model layout)\n");
+            return;
+        }
+
+        append_buffer(GL_ARRAY_BUFFER, 0, std::as_bytes(std::span{ batch.vertex }));
+        append_buffer(GL_ELEMENT_ARRAY_BUFFER, 1, std::as_bytes(std::span{ batch.indexes }));
+
+        m_indexes_count += std::size(batch.indexes);
+    }
+
     auto render() -> void override {
         glEnableClientState(GL_VERTEX_ARRAY);
 
         glBindBuffer(GL_ARRAY_BUFFER, m_vbo_handles[0]);
-        glVertexPointer(3, GL_FLOAT, 0, 0l);
+        glVertexPointer(3, GL_FLOAT, m_stride, 0l);
+
+        auto offset = sizeof(float) * 3;
+
+        if (m_attributes & io::vertex_texture) {
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, m_stride, reinterpret_cast<void const*>(offset));
+            offset += sizeof(float) * 2;
+        }
+
+        if (m_attributes & io::vertex_normal) {
+            glEnableClientState(GL_NORMAL_ARRAY);
+            glNormalPointer(GL_FLOAT, m_stride, reinterpret_cast<void const*>(offset));
+        }
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vbo_handles[1]);
-        glDrawElements(GL_TRIANGLES, std::size(m_indexes), GL_UNSIGNED_SHORT, 0l);
+        glDrawElements(GL_TRIANGLES, m_indexes_count, m_index_type, 0l);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        if (m_attributes & io::vertex_normal) {
+            glDisableClientState(GL_NORMAL_ARRAY);
+        }
+        if (m_attributes & io::vertex_texture) {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
         glDisableClientState(GL_VERTEX_ARRAY);
     };
 
     ~Model() override = default;
+
+private:
+    /* Grows buffer i to fit bytes after its used part, then writes them there */
+    auto append_buffer(GLenum target, std::size_t i, std::span<std::byte const> bytes) -> void {
+        if (m_used[i] + std::size(bytes) > m_capacity[i]) {
+            auto capacity = std::max(m_capacity[i] * 2, m_used[i] + std::size(bytes));
+            auto handle = std::uint32_t{};
+
+            glGenBuffers(1, &handle);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, handle);
+            glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+
+            if (m_used[i] > 0) {
+                glBindBuffer(GL_COPY_READ_BUFFER, m_vbo_handles[i]);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, m_used[i]);
+                glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            }
+
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &m_vbo_handles[i]);
+
+            m_vbo_handles[i] = handle;
+            m_capacity[i] = capacity;
+        }
+
+        glBindBuffer(target, m_vbo_handles[i]);
+        glBufferSubData(target, m_used[i], std::size(bytes), std::data(bytes));
+        glBindBuffer(target, 0);
+
+        m_used[i] += std::size(bytes);
+    }
 };
 
 }
@@ -21,6 +21,8 @@
 #include "../gl-shaders/light_fs.hpp"
 
 #include "../geometry/2d/vector.hpp"
+#include "../geometry/3d/expression.hpp"
+#include "../geometry/glm_interop.hpp"
 #include "../io/obj_reader.hpp"
 #include "../rng/core.hpp"
 
@@ -28,6 +30,7 @@
 
 #include "./Entity_Base.hpp"
 #include "./Model.hpp"
+#include "./Streaming_Model.hpp"
 #include "./Entity_Owner.hpp"
 #include "./Solid_Sphere.hpp"
 
@@ -84,7 +87,7 @@ public:
     bool m_update;
 
     /* Camera */
-    glm::vec2 m_camera_angle;
+    Quaternionf m_camera;
     glm::mat4 m_view;
 
     /* Shaders */
@@ -117,7 +120,7 @@ public:
             m_entities(),
             m_collision_tracker(),
             m_update(true),
-            m_camera_angle({ 120.0f, 0.0f }),
+            m_camera(Quaternionf::axis_angle({ 1.0f, 0.0f, 0.0f }, glm::radians(120.0f))),
             m_view(),
             m_shader_main(0),
             m_shader_grid(0),
@@ -195,17 +198,21 @@ private:
                         ptr->set_sprint_key(md2::Model_Sprints[m_md2_current]);
                     }
 
+                    /* pitch about the view x axis, yaw about the model y axis */
+                    auto pitch = [](float degrees) { return Quaternionf::axis_angle({ 1.0f, 0.0f, 0.0f }, glm::radians(degrees)); };
+                    auto yaw = [](float degrees) { return Quaternionf::axis_angle({ 0.0f, 1.0f, 0.0f }, glm::radians(degrees)); };
+
                     if (event.key.code == sf::Keyboard::Numpad8) {
-                        m_camera_angle.x += 10.0f;
+                        m_camera = normalize(pitch(10.0f) * m_camera);
                     }
                     else if (event.key.code == sf::Keyboard::Numpad6) {
-                        m_camera_angle.y += 10.0f;
+                        m_camera = normalize(m_camera * yaw(10.0f));
                     }
                     else if (event.key.code == sf::Keyboard::Numpad2) {
-                        m_camera_angle.x -= 10.0f;
+                        m_camera = normalize(pitch(-10.0f) * m_camera);
                     }
                     else if (event.key.code == sf::Keyboard::Numpad4) {
-                        m_camera_angle.y -= 10.0f;
+                        m_camera = normalize(m_camera * yaw(-10.0f));
                     }
 
                     if (event.key.code == sf::Keyboard::Y) {
@@ -272,8 +279,7 @@ private:
     auto update(sf::Time elapsed) -> void {
         m_projection = glm::mat4(1.0f);
 
-        m_view = glm::rotate(glm::radians(m_camera_angle.x), glm::vec3{ 1.0f, 0.0f, 0.0f })
-                    * glm::rotate(glm::radians(m_camera_angle.y), glm::vec3{ 0.0f, 1.0f, 0.0f });
+        m_view = to_glm(GL_Mat4(m_camera));
 
         update_wave(elapsed);
         update_shaders();
@@ -333,18 +339,19 @@ private:
     auto spawn() -> void {
         //spawn_spheres();
         //spawn_wv_vbos();
+        //spawn_wv_stream();
         //spawn_md2_vbos();
         //spawn_water();
         spawn_another_brick_in_the_wall();
     }
 
     auto spawn_wv_vbos() -> void {
-        auto model = std::make_shared<Model>(io::read_wavefront<float>("../../wv-obj/tank-i.obj"));
+        auto model = std::make_shared<Model>(io::load_mesh("../../wv-obj/tank-i.obj"));
         model->load();
 
         auto e1 = std::make_shared<Entity_Owner>(model, Vector_3Df{ -0.5f,   -0.5f,  0.1f });
 
-        auto model2 = std::make_shared<Model>(io::read_wavefront<float>("../../wv-obj/orc.obj"));
+        auto model2 = std::make_shared<Model>(io::load_mesh("../../wv-obj/orc.obj"));
         model2->load();
 
         auto e2 = std::make_shared<Entity_Owner>(model2, Vector_3Df{ 0.5f,   -0.5f,  0.1f });
@@ -353,6 +360,14 @@ private:
         m_entities.push_back(e2);
     }
 
+    /* Appears batch by batch while the file is read, for meshes too big to parse up front */
+    auto spawn_wv_stream() -> void {
+        auto model = std::make_shared<Streaming_Model>("../../wv-obj/orc.obj");
+        model->load();
+
+        m_entities.push_back(std::make_shared<Entity_Owner>(model, Vector_3Df{ 0.0f, -0.5f, 0.1f }));
+    }
+
     auto spawn_md2_vbos() -> void {
         auto resource = md2::io::read("../../md2-obj/cathos.md2", "../../md2-obj/cathos.png");
 
@@ -445,13 +460,14 @@ private:
     auto handle_collisions() -> void {
         using namespace std::chrono_literals;
 
+        /* Lazy operands, each new direction is evaluated component by component without intermediate vectors */
         auto simple_response = [](Solid_Sphere * left, Solid_Sphere * right) {
-            auto project = []<Dim3_Vec U, Dim3_Vec V>(U const& u, V const& v) {
+            auto project = []<class U, class V>(U const& u, V const& v) {
                 return scale(v, dot_product(u, v) / dot_product(v, v));
             };
 
-            auto v1 = left->m_orientation;
-            auto v2 = right->m_orientation;
+            auto v1 = lazy(Vector_3Df{ left->m_orientation });
+            auto v2 = lazy(Vector_3Df{ right->m_orientation });
 
             left->set_movement(left->m_speed, v1 + project(v2, v2 - v1) - project(v1, v1 - v2));
             right->set_movement(right->m_speed, v2 + project(v1, v2 - v1) - project(v2, v1 - v2));
@@ -9,6 +9,7 @@
 
 #include "../gl.hpp"
 
+#include "../geometry/trig.hpp"
 #include "../geometry/3d/vector.hpp"
 #include "./Entity_Base.hpp"
 
@@ -39,13 +40,27 @@ public:
         auto const R = 1.0f / static_cast<float>(rings - 1);
         auto const S = 1.0f / static_cast<float>(sectors - 1);
 
+        /* one sincos per ring and per sector instead of four calls per vertex, sin(x - pi / 2) = -cos(x) */
+        auto ring_angle = std::vector<float>(rings), ring_sin = ring_angle, ring_cos = ring_angle;
+        auto sector_angle = std::vector<float>(sectors), sector_sin = sector_angle, sector_cos = sector_angle;
+
+        for(auto r = 0ul; r < rings; ++r) {
+            ring_angle[r] = PI * r * R;
+        }
+        for(auto s = 0ul; s < sectors; ++s) {
+            sector_angle[s] = 2 * PI * s * S;
+        }
+
+        sincos<Trig_Precision::fast, float>(ring_angle, ring_sin, ring_cos);
+        sincos<Trig_Precision::fast, float>(sector_angle, sector_sin, sector_cos);
+
         auto v = std::begin(m_vertices);
 
         for(auto r = 0ul; r < rings; ++r) {
             for(auto s = 0ul; s < sectors; ++s) {
-                float const i = std::sin(-(PI / 2) + PI * r * R);
-                float const j = std::cos(2 * PI * s * S) * std::sin(PI * r * R);
-                float const k = std::sin(2 * PI * s * S) * std::sin(PI * r * R);
+                float const i = -ring_cos[r];
+                float const j = sector_cos[s] * ring_sin[r];
+                float const k = sector_sin[s] * ring_sin[r];
 
                 *v++ = j * radius;
                 *v++ = i * radius;
@@ -0,0 +1,58 @@
+#ifndef CPP_ENGINE_STREAMING_MODEL_HPP
+#define CPP_ENGINE_STREAMING_MODEL_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include "./Model.hpp"
+#include "../io/mesh_stream.hpp"
+
+namespace engine {
+
+/**
+ * Model that shows up while its OBJ is read. Each update appends up to batches_per_frame ready batches to the
+ * GPU buffers, the reader waits on the queue meanwhile, and the stream is dropped once the file is through.
+ * */
+class Streaming_Model : public Model {
+    std::unique_ptr<io::Mesh_Stream> m_stream;
+    std::size_t m_batches_per_frame;
+
+public:
+    explicit Streaming_Model(std::filesystem::path path, std::size_t batches_per_frame = 2, std::size_t depth = 4) :
+     Model(io::Mesh{}),
+     m_stream(std::make_unique<io::Mesh_Stream>(std::move(path), depth)),
+     m_batches_per_frame(batches_per_frame)
+    {}
+
+    auto update(float seconds) -> void override {
+        if (!m_stream) {
+            return;
+        }
+
+        for (auto i = 0ul; i < m_batches_per_frame; ++i) {
+            auto batch = m_stream->try_pop();
+
+            if (!batch) {
+                break;
+            }
+            append(*batch);
+        }
+
+        if (m_stream->finished()) {
+            m_stream.reset();
+        }
+    }
+
+    /* Every batch is on the GPU */
+    [[nodiscard]] auto complete() const -> bool {
+        return !m_stream;
+    }
+
+    ~Streaming_Model() override = default;
+};
+
+}
+
+#endif //CPP_ENGINE_STREAMING_MODEL_HPP
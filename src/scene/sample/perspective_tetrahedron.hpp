@@ -1,7 +1,7 @@
 #ifndef CPP_ENGINE_PERSPECTIVE_TETRAHEDRON_HPP
 #define CPP_ENGINE_PERSPECTIVE_TETRAHEDRON_HPP
 
-#include <numbers>
+#include <algorithm>
 #include <array>
 
 #include <fmt/core.h>
@@ -12,6 +12,7 @@
 #include "../../geometry/core.hpp"
 #include "../../pixel-buffer.hpp"
 #include "../../draw.hpp"
+#include "../../texture/upload.hpp"
 
 template <std::size_t width, std::size_t height, class T = double>
 class Perspective_Tetrahedron_Runner {
@@ -19,6 +20,7 @@ class Perspective_Tetrahedron_Runner {
 
     sf::Texture pixels_texture;
     sf::Sprite pixels_sprite;
+    engine::Texture_Uploader uploader;
 
     /* Example data */
     engine::Tetrahedron<T> tetrahedron;
@@ -33,6 +35,7 @@ public:
         pixels(width, height, 255u),
         pixels_texture{},
         pixels_sprite{},
+        uploader{},
         tetrahedron{{ {{300, 200, 0}, {400, 300, 0}, {200, 300, 0}, {300, 250, 100}} }},
         angle{0},
         angle_step{15},
@@ -69,17 +72,18 @@ public:
                     /* move forth */
                     engine::Mat4::translate(0, 250, 0) *
                     /* rotate angle */
-                    engine::Mat4::rotate(axis::X, angle * (std::numbers::pi / 180.0)) *
+                    engine::Mat4::rotate(axis::X, engine::Degrees{ double(angle) }) *
                     /* move to origin */
                     engine::Mat4::translate(0, -250, 0)
             );
 
-            auto tetrahedron_copy = tetrahedron;
-            for (auto & v : tetrahedron_copy.vertex) {
-                v = v * transform;
-            }
+            /* stay in clip space, the divide happens after clipping */
+            auto clip = std::array<engine::Vector_4D<T>, 4>{};
+            std::ranges::transform(tetrahedron.vertex, std::begin(clip), [&transform](auto const& v) {
+                return engine::apply_projective(v, transform);
+            });
 
-            update_pixels(tetrahedron_copy);
+            update_pixels(clip);
         }
     }
 
@@ -90,19 +94,28 @@ public:
 
 private:
 
-    template <class Shape>
-    auto update_pixels(Shape shape) -> void {
-        std::fill(std::begin(pixels), std::end(pixels), 255u);
+    auto update_pixels(engine::Tetrahedron<T> const& shape) -> void {
+        auto clip = std::array<engine::Vector_4D<T>, 4>{};
+        std::ranges::transform(shape.vertex, std::begin(clip), [](auto const& v) {
+            return engine::Vector_4D<T>{ v.x, v.y, v.z, 1 };
+        });
+
+        update_pixels(clip);
+    }
+
+    auto update_pixels(std::array<engine::Vector_4D<T>, 4> const& clip) -> void {
+        pixels.clear({ 255u, 255u, 255u, 255u });
 
         auto color = std::array<std::uint8_t, 4>{ 0, 0, 0, 255 };
-        auto [p1, p2, p3, p4] = shape.vertex;
+        auto [p1, p2, p3, p4] = clip;
 
-        engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p1.x, p1.y}, {p2.x, p2.y}, {p3.x, p3.y}} }}, color);
-        engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p1.x, p1.y}, {p2.x, p2.y}, {p4.x, p4.y}} }}, color);
-        engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p2.x, p2.y}, {p3.x, p3.y}, {p4.x, p4.y}} }}, color);
-        engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p3.x, p3.y}, {p1.x, p1.y}, {p4.x, p4.y}} }}, color);
+        /* points behind the eye no longer flip across the screen */
+        engine::draw_triangle(pixels, std::array{ p1, p2, p3 }, color);
+        engine::draw_triangle(pixels, std::array{ p1, p2, p4 }, color);
+        engine::draw_triangle(pixels, std::array{ p2, p3, p4 }, color);
+        engine::draw_triangle(pixels, std::array{ p3, p1, p4 }, color);
 
-        pixels_texture.update(std::data(pixels));
+        uploader.update(pixels_texture, pixels);
     }
 };
 
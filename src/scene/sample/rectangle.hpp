@@ -1,7 +1,6 @@
 #ifndef CPP_ENGINE_RECTANGLE_HPP
 #define CPP_ENGINE_RECTANGLE_HPP
 
-#include <numbers>
 #include <array>
 
 #include <SFML/Graphics.hpp>
@@ -9,6 +8,7 @@
 #include "../../geometry/core.hpp"
 #include "../../pixel-buffer.hpp"
 #include "../../draw.hpp"
+#include "../../texture/upload.hpp"
 
 template <std::size_t width, std::size_t height, class T = double>
 class Rectangle_Runner {
@@ -16,6 +16,7 @@ class Rectangle_Runner {
 
     sf::Texture pixels_texture;
     sf::Sprite pixels_sprite;
+    engine::Texture_Uploader uploader;
 
     /* Example data */
     engine::Rectangle<T> rect;
@@ -29,6 +30,7 @@ public:
         pixels(width, height, 255u),
         pixels_texture{},
         pixels_sprite{},
+        uploader{},
         rect{ {{ {100, 100}, {300, 100}, {300, 300}, {100, 300} }} },
         click{0, 0},
         shift{10},
@@ -59,9 +61,9 @@ public:
 
                 /* Rotate */
                 if (event.key.code == sf::Keyboard::A) {
-                    return engine::Mat3::rotate(angle * (std::numbers::pi / 180.0));
+                    return engine::Mat3::rotate(engine::Degrees{ double(angle) });
                 } else if (event.key.code == sf::Keyboard::S) {
-                    return engine::Mat3::rotate(-angle * (std::numbers::pi / 180.0));
+                    return engine::Mat3::rotate(engine::Degrees{ -double(angle) });
                 }
 
                 return engine::Mat3::identity();
@@ -96,11 +98,11 @@ public:
 private:
 
     auto update_pixels() -> void {
-        std::fill(std::begin(pixels), std::end(pixels), 255u);
+        pixels.clear({ 255u, 255u, 255u, 255u });
 
         engine::draw_rect(pixels, rect, { 0, 255, 0, 255 });
 
-        pixels_texture.update(std::data(pixels));
+        uploader.update(pixels_texture, pixels);
     }
 };
 
@@ -1,7 +1,6 @@
 #ifndef CPP_ENGINE_TETRAHEDRON_HPP
 #define CPP_ENGINE_TETRAHEDRON_HPP
 
-#include <numbers>
 #include <array>
 
 #include <fmt/core.h>
@@ -12,6 +11,7 @@
 #include "../../geometry/core.hpp"
 #include "../../pixel-buffer.hpp"
 #include "../../draw.hpp"
+#include "../../texture/upload.hpp"
 
 template <std::size_t width, std::size_t height, class T = double>
 class Tetrahedron_Runner {
@@ -19,6 +19,7 @@ class Tetrahedron_Runner {
 
     sf::Texture pixels_texture;
     sf::Sprite pixels_sprite;
+    engine::Texture_Uploader uploader;
 
     /* Example data */
     engine::Tetrahedron<T> tetrahedron;
@@ -32,6 +33,7 @@ public:
         pixels(width, height, 255u),
         pixels_texture{},
         pixels_sprite{},
+        uploader{},
         tetrahedron{{ {{300, 200, 0}, {400, 300, 0}, {200, 300, 0}, {300, 250, 100}} }},
         click{0, 0},
         shift{10},
@@ -62,11 +64,11 @@ public:
 
                 /* Rotate */
                 if (event.key.code == sf::Keyboard::X) {
-                    return engine::Mat4::rotate(axis::X, angle * (std::numbers::pi / 180.0) * (1 - 2 * event.key.shift));
+                    return engine::Mat4::rotate(axis::X, engine::Degrees{ double(angle * (1 - 2 * event.key.shift)) });
                 } else if (event.key.code == sf::Keyboard::Y) {
-                    return engine::Mat4::rotate(axis::Y, angle * (std::numbers::pi / 180.0) * (1 - 2 * event.key.shift));
+                    return engine::Mat4::rotate(axis::Y, engine::Degrees{ double(angle * (1 - 2 * event.key.shift)) });
                 } else if (event.key.code == sf::Keyboard::Z) {
-                    return engine::Mat4::rotate(axis::Z, angle * (std::numbers::pi / 180.0) * (1 - 2 * event.key.shift));
+                    return engine::Mat4::rotate(axis::Z, engine::Degrees{ double(angle * (1 - 2 * event.key.shift)) });
                 }
 
                 return engine::Mat4::identity();
@@ -101,7 +103,7 @@ public:
 private:
 
     auto update_pixels() -> void {
-        std::fill(std::begin(pixels), std::end(pixels), 255u);
+        pixels.clear({ 255u, 255u, 255u, 255u });
 
         auto color = std::array<std::uint8_t, 4>{ 0, 0, 0, 255 };
         auto [p1, p2, p3, p4] = tetrahedron.vertex;
@@ -111,7 +113,7 @@ private:
         engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p2.x, p2.y}, {p3.x, p3.y}, {p4.x, p4.y}} }}, color);
         engine::draw_triangle(pixels, engine::Triangle<T>{{ {{p3.x, p3.y}, {p1.x, p1.y}, {p4.x, p4.y}} }}, color);
 
-        pixels_texture.update(std::data(pixels));
+        uploader.update(pixels_texture, pixels);
     }
 };
 
@@ -2,11 +2,10 @@
 #define CPP_ENGINE_WAVEFRONT_RUNNER_HPP
 
 #include <array>
+#include <atomic>
 #include <execution>
-#include <numbers>
 #include <numeric>
-#include <ranges>
-#include <type_traits>
+#include <optional>
 #include <utility>
 
 #include <fmt/core.h>
@@ -15,12 +14,24 @@
 
 #include "../../geometry/core.hpp"
 #include "../../pixel-buffer.hpp"
+#include "../../depth-buffer.hpp"
+#include "../../frame-pipeline.hpp"
 #include "../../draw.hpp"
+#include "../../texture/upload.hpp"
+#include "../../raster/cull.hpp"
+#include "../../raster/tiled.hpp"
+#include "../../raster/triangle.hpp"
 
 template <std::size_t width, std::size_t height, class T = double>
 class Wavefront_Runner {
-    using Vertex = std::add_lvalue_reference_t<decltype(engine::Solid<T>::vertex)>;
-    using MinMax = std::invoke_result_t<decltype(std::ranges::minmax_element), Vertex, engine::less_t<axis::X_t>>;
+
+    /* Everything a frame needs, the worker never reads the gui state */
+    struct Frame_Job {
+        engine::Mat4 transform;
+        bool filled;
+        bool tiled;
+        bool cull_back;
+    };
 
     /* Solid data */
     engine::Solid<T> solid;
@@ -28,47 +39,72 @@ class Wavefront_Runner {
 
     /* Pixel data */
     engine::Basic_RGBA_Buffer pixels;
+    engine::Tiled_Rasterizer<> raster;
+    engine::Depth_Buffer<float> depth;
+    engine::Face_Culler<T> culler;
     sf::Texture pixels_texture;
     sf::Sprite pixels_sprite;
+    engine::Texture_Uploader uploader;
+    engine::Frame_Pipeline<Frame_Job> pipeline;
+    std::optional<Frame_Job> pending;
 
     /* Transform data */
-    /* Bound. Box  */ MinMax bb_x, bb_y, bb_z;
+    /* Bound. Box  */ engine::Aabb<T> box;
     /* Centroid    */ T center_x, center_y, center_z;
     /* Click       */ T click_x, click_y;
-    /* Angle       */ T angle_x, angle_y, angle_z, angle_step;
+    /* Orientation */ engine::Quaterniond orientation;
+    /* Angle       */ T angle_step;
     /* Cent. Proj. */ T cp, cp_step;
     /* Movement    */ T move_x, move_y, move_step;
     /* Scale       */ T scale, scale_step;
+    /* Spin        */ T spin_step;
+
+    /* Cull counters, written by whichever thread draws */
+    std::atomic<std::size_t> faces_drawn, faces_back, faces_outside, edges_drawn;
 
     /* gui status */
     bool show_debug;
+    bool tiled;
+    bool filled;
+    bool pipelined;
+    bool spin;
+    bool cull_back;
 
 public:
     Wavefront_Runner(engine::Solid<T> && p_solid) :
             solid{std::move(p_solid)},
             view{solid},
-            pixels(width, height, 255u), pixels_texture{}, pixels_sprite{},
-            bb_x{std::ranges::minmax_element(solid.vertex, engine::less(axis::X))},
-            bb_y{std::ranges::minmax_element(solid.vertex, engine::less(axis::Y))},
-            bb_z{std::ranges::minmax_element(solid.vertex, engine::less(axis::Z))},
-            center_x{std::midpoint(bb_x.max->x, bb_x.min->x)},
-            center_y{std::midpoint(bb_y.max->y, bb_y.min->y)},
-            center_z{std::midpoint(bb_z.max->z, bb_z.min->z)},
+            pixels(width, height, 255u), raster(width, height), depth(width, height), culler{}, pixels_texture{}, pixels_sprite{}, uploader{},
+            pipeline(width, height, 3, [this](Frame_Job const& job, engine::Basic_RGBA_Buffer & frame) {
+                draw_frame(job, frame);
+            }),
+            pending{},
+            box{solid.bounding_box()},
+            center_x{box.center().x},
+            center_y{box.center().y},
+            center_z{box.center().z},
             click_x{}, click_y{},
-            angle_x{0}, angle_y{0}, angle_z{0}, angle_step{15},
+            orientation{}, angle_step{15},
             cp{500}, cp_step{50},
             move_x{offset(width / 2.0, center_x)},
             move_y{offset(height / 2.0, center_x)},
             move_step{50},
             scale{1}, scale_step{0.5},
-            show_debug{false}
+            spin_step{1},
+            faces_drawn{}, faces_back{}, faces_outside{}, edges_drawn{},
+            show_debug{false},
+            tiled{true},
+            filled{false},
+            pipelined{false},
+            spin{false},
+            cull_back{true}
     {
         pixels_texture.create(width, height);
         pixels_texture.update(std::data(pixels));
         pixels_sprite.setTexture(pixels_texture);
 
-        fmt::print("Min [ {} {} {} ] Max [ {} {} {} ]\n", bb_x.min->x, bb_y.min->y, bb_z.min->z,
-                   bb_x.max->x, bb_y.max->y, bb_z.max->z);
+        fmt::print("Min [ {} {} {} ] Max [ {} {} {} ]\n", box.min.x, box.min.y, box.min.z,
+                   box.max.x, box.max.y, box.max.z);
     }
 
     template <class W, class E>
@@ -93,15 +129,15 @@ public:
                 scale += scale_step * (1 - 2 * event.key.shift);
             }
 
-            /* Rotate */
+            /* Rotate, about the view axes */
             if (event.key.code == sf::Keyboard::X) { /* X */
-                angle_x += angle_step * (1 - 2 * event.key.shift);
+                turn(axis::X, angle_step * (1 - 2 * event.key.shift));
             }
             if (event.key.code == sf::Keyboard::Y) { /* Y */
-                angle_y += angle_step * (1 - 2 * event.key.shift);
+                turn(axis::Y, angle_step * (1 - 2 * event.key.shift));
             }
             if (event.key.code == sf::Keyboard::Z) { /* Z */
-                angle_z += angle_step * (1 - 2 * event.key.shift);
+                turn(axis::Z, angle_step * (1 - 2 * event.key.shift));
             }
 
             /* Update perspective */
@@ -112,7 +148,7 @@ public:
             }
 
             /* Pivot Movement */
-            auto [ pivot_x, pivot_y, pivot_z ] = [&]() -> engine::Vector_3D<T> {
+            auto pivot = [&]() -> engine::Vector_3D<T> {
                 if (event.key.alt) return { click_x, click_y, 0 };
                 return { 0, 0, 0 };
             }();
@@ -122,33 +158,7 @@ public:
                 show_debug = !show_debug;
             }
 
-            auto transform = (
-                    /* translate away from cp*/
-                    //engine::Mat4::translate(-center_x, -center_y, -center_z) *
-                    /* perspective */
-                    //engine::Mat4::simple_perspective(n, q, aspect_ratio) *
-                    /* move forth */
-                    engine::Mat4::translate(center_x, center_y, center_z) *
-                    /* translate to pivot */
-                    engine::Mat4::translate(pivot_x, pivot_y, pivot_z) *
-                    /* translate */
-                    engine::Mat4::translate(move_x, move_y, 0) *
-                    /* scale */
-                    engine::Mat4::scale(scale, -scale, scale) * // mirror y [negative scale]
-                    /* rotate angle */
-                    engine::Mat4::rotate(axis::Z, angle_z * (std::numbers::pi / 180.0)) *
-                    engine::Mat4::rotate(axis::Y, angle_y * (std::numbers::pi / 180.0)) *
-                    engine::Mat4::rotate(axis::X, angle_x * (std::numbers::pi / 180.0)) *
-                    /* move to origin */
-                    engine::Mat4::translate(-center_x, -center_y, -center_z) *
-                    /* noop */
-                    engine::Mat4::identity()
-            );
-
-            std::transform(std::execution::par_unseq, std::cbegin(solid.vertex), std::cend(solid.vertex),
-                            std::begin(view.vertex), [transform](auto const& v) { return v * transform; });
-
-            update_pixels(view);
+            schedule(transform(pivot));
         } else if (event.type == sf::Event::MouseButtonPressed) {
             if (event.mouseButton.button == sf::Mouse::Left) {
                 auto [ x, y ] = sf::Mouse::getPosition(window);
@@ -160,6 +170,21 @@ public:
 
     template <class W>
     auto render(W & window) -> void {
+        if (spin) {
+            turn(axis::Y, spin_step);
+            schedule(transform({ 0, 0, 0 }));
+        }
+
+        if (pipelined) {
+            if (pending && pipeline.submit(*pending)) {
+                pending.reset();
+            }
+
+            pipeline.present([this](engine::Basic_RGBA_Buffer & frame) {
+                uploader.update(pixels_texture, frame);
+            });
+        }
+
         window.render(pixels_sprite);
         if (show_debug) {
             imgui();
@@ -171,23 +196,98 @@ private:
         return ref - target;
     }
 
-    template <class Shape>
-    auto update_pixels(Shape const& shape) -> void {
-        std::fill(std::begin(pixels), std::end(pixels), 255u);
+    /* Orientation turns by one step, kept unit length so repeated turns do not drift. Whole degree steps hit the table */
+    template <axis::Axis A>
+    auto turn(A axis, T degrees) -> void {
+        orientation = engine::normalize(engine::Quaterniond::rotate(axis, engine::Degrees{ double(degrees) }) * orientation);
+    }
+
+    /* Tagged factors, the translations fold together and the rest becomes one affine product */
+    auto transform(engine::Vector_3D<T> pivot) const -> engine::Mat4 {
+        return (
+            /* translate away from cp*/
+            //engine::Translation(-center_x, -center_y, -center_z) *
+            /* perspective */
+            //engine::Mat4::simple_perspective(n, q, aspect_ratio) *
+            /* move forth */
+            engine::Translation(center_x, center_y, center_z) *
+            /* translate to pivot */
+            engine::Translation(pivot.x, pivot.y, pivot.z) *
+            /* translate */
+            engine::Translation(move_x, move_y, 0) *
+            /* scale */
+            engine::Scaling(scale, -scale, -scale) * // mirror y, flip z so closer is smaller [negative scale]
+            /* rotate */
+            orientation *
+            /* move to origin */
+            engine::Translation(-center_x, -center_y, -center_z) *
+            /* noop */
+            engine::Identity()
+        );
+    }
+
+    /* Pipelined frames wait for the next render, the latest one wins */
+    auto schedule(engine::Mat4 const& model) -> void {
+        auto job = Frame_Job{ model, filled, tiled, cull_back };
+
+        if (pipelined) {
+            pending = job;
+            return;
+        }
+
+        /* view, raster and depth belong to the worker until it is done */
+        pending.reset();
+        pipeline.wait_idle();
+        draw_frame(job, pixels);
+        uploader.update(pixels_texture, pixels);
+    }
+
+    auto draw_frame(Frame_Job const& job, engine::Basic_RGBA_Buffer & frame) -> void {
+        view.edit_vertices([this, &job](auto vertex) {
+            engine::transform_points<T>(std::execution::par, solid.vertex(), job.transform, vertex);
+        });
+        view.update_bounds(); /* lets the culler settle the view test for the whole model */
+
+        auto visible = culler.cull(std::execution::par, view, width, height, { .back_faces = job.cull_back });
+        auto const& stats = culler.stats();
+
+        faces_drawn = stats.drawn;
+        faces_back = stats.back;
+        faces_outside = stats.outside;
+        edges_drawn = stats.edges_drawn;
+
+        frame.clear({ 255u, 255u, 255u, 255u });
 
         auto color = std::array<std::uint8_t, 4>{ 0, 0, 0, 255 };
-        engine::draw_solid(pixels, shape, color);
 
-        pixels_texture.update(std::data(pixels));
+        if (job.filled) {
+            depth.clear();
+            engine::draw_solid(frame, depth, view, visible, [this](std::size_t face) {
+                return engine::flat_shade(view, face);
+            });
+        } else if (job.tiled) {
+            engine::draw_solid(raster, view, visible, color);
+            raster.flush(frame);
+        } else {
+            engine::draw_solid(frame, view, visible, color);
+        }
     }
 
     auto imgui() -> void {
         ImGui::Begin("Debug");
 
-        ImGui::TextColored({ 255, 255, 255, 255 }, "Vertex %lu Faces %lu", std::size(solid.vertex), std::size(solid.faces));
+        ImGui::TextColored({ 255, 255, 255, 255 }, "Vertex %lu Faces %lu", std::size(solid.vertex()), std::size(solid.faces()));
+        ImGui::Text("Drawn faces %lu edges %lu", faces_drawn.load(), edges_drawn.load());
+        ImGui::Text("Culled back %lu outside %lu", faces_back.load(), faces_outside.load());
         ImGui::InputDouble("Angle step", &angle_step);
         ImGui::InputDouble("Scale step", &scale_step);
         ImGui::InputDouble("Move step", &move_step);
+        ImGui::Checkbox("Tiled raster", &tiled);
+        ImGui::Checkbox("Depth fill", &filled);
+        ImGui::Checkbox("Cull back faces", &cull_back);
+        ImGui::Checkbox("Pipelined", &pipelined);
+        ImGui::Checkbox("Spin", &spin);
+        ImGui::InputDouble("Spin step", &spin_step);
 
         ImGui::End();
     }
@@ -0,0 +1,178 @@
+#ifndef CPP_ENGINE_TEXTURE_SAMPLER_HPP
+#define CPP_ENGINE_TEXTURE_SAMPLER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "../utility/cpu.hpp"
+
+namespace engine {
+
+enum class Sampling {
+    nearest,
+    bilinear
+};
+
+/**
+ * Non owning view over RGBA8 texels, coordinates repeat like GL_REPEAT.
+ * v = 0 is the first row in memory, the same texels the GL path uploads.
+ * */
+struct Texture_View {
+    std::uint8_t const* pixels;
+    int width;
+    int height;
+};
+
+/* engine::Texture and md2::Texture keep their texels under different names */
+template <class Texture>
+auto texture_view(Texture const& texture) -> Texture_View {
+    if constexpr (requires { texture.m_buffer; }) {
+        return { std::data(texture.m_buffer), int(texture.m_width), int(texture.m_height) };
+    } else {
+        return { std::data(texture.buffer), int(texture.width), int(texture.height) };
+    }
+}
+
+} // namespace engine
+
+namespace engine::details {
+
+inline auto fetch_texel(Texture_View const& texture, int x, int y) -> std::uint32_t {
+    auto texel = std::uint32_t{};
+    std::memcpy(&texel, texture.pixels + (std::size_t(y) * texture.width + x) * 4, sizeof(texel));
+    return texel;
+}
+
+/* Fractional part, [0, 1) for any sign */
+inline auto repeat(float t) -> float {
+    return t - std::floor(t);
+}
+
+/* Bilinear footprint on one axis, texel centers at half integers */
+struct Bilinear_Axis {
+    int i0, i1;
+    float weight;
+};
+
+inline auto bilinear_axis(float t, int size) -> Bilinear_Axis {
+    auto p = repeat(t) * float(size) - 0.5f;
+    auto f = std::floor(p);
+    auto i0 = int(f);
+
+    if (i0 < 0) {
+        i0 += size;
+    }
+
+    return { i0, i0 + 1 == size ? 0 : i0 + 1, p - f };
+}
+
+inline auto sample_nearest(Texture_View const& texture, float u, float v) -> std::uint32_t {
+    auto x = std::min(int(repeat(u) * float(texture.width)), texture.width - 1);
+    auto y = std::min(int(repeat(v) * float(texture.height)), texture.height - 1);
+
+    return fetch_texel(texture, x, y);
+}
+
+inline auto sample_bilinear(Texture_View const& texture, float u, float v) -> std::uint32_t {
+    auto [ x0, x1, ax ] = bilinear_axis(u, texture.width);
+    auto [ y0, y1, ay ] = bilinear_axis(v, texture.height);
+
+    auto c00 = fetch_texel(texture, x0, y0), c10 = fetch_texel(texture, x1, y0);
+    auto c01 = fetch_texel(texture, x0, y1), c11 = fetch_texel(texture, x1, y1);
+
+    auto texel = std::uint32_t{};
+
+    /* channel by channel, in the same operation order as the vector kernel */
+    for (auto shift = 0u; shift < 32u; shift += 8u) {
+        auto channel = [shift](std::uint32_t c) { return float((c >> shift) & 0xFFu); };
+
+        auto top = channel(c00) + (channel(c10) - channel(c00)) * ax;
+        auto bottom = channel(c01) + (channel(c11) - channel(c01)) * ax;
+
+        texel |= std::uint32_t(std::lrint(top + (bottom - top) * ay)) << shift;
+    }
+
+    return texel;
+}
+
+inline auto sample(Texture_View const& texture, Sampling sampling, float u, float v) -> std::uint32_t {
+    return sampling == Sampling::nearest ? sample_nearest(texture, u, v) : sample_bilinear(texture, u, v);
+}
+
+#if defined(CPP_ENGINE_X86)
+
+/* Eight texels at once, lanes outside mask are left zero and never read */
+CPP_ENGINE_TARGET_AVX2
+inline auto gather_texels(Texture_View const& texture, __m256i x, __m256i y, __m256i mask) -> __m256i {
+    auto index = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(texture.width)), x);
+    return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<int const*>(texture.pixels), index, mask, 4);
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto repeat_x8(__m256 t) -> __m256 {
+    return _mm256_sub_ps(t, _mm256_floor_ps(t));
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto sample_nearest_x8(Texture_View const& texture, __m256 u, __m256 v, __m256i mask) -> __m256i {
+    auto x = _mm256_cvttps_epi32(_mm256_mul_ps(repeat_x8(u), _mm256_set1_ps(float(texture.width))));
+    auto y = _mm256_cvttps_epi32(_mm256_mul_ps(repeat_x8(v), _mm256_set1_ps(float(texture.height))));
+
+    x = _mm256_min_epi32(x, _mm256_set1_epi32(texture.width - 1));
+    y = _mm256_min_epi32(y, _mm256_set1_epi32(texture.height - 1));
+
+    return gather_texels(texture, x, y, mask);
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto bilinear_axis_x8(__m256 t, int size, __m256i & i0, __m256i & i1) -> __m256 {
+    auto p = _mm256_sub_ps(_mm256_mul_ps(repeat_x8(t), _mm256_set1_ps(float(size))), _mm256_set1_ps(0.5f));
+    auto f = _mm256_floor_ps(p);
+    auto extent = _mm256_set1_epi32(size);
+
+    i0 = _mm256_cvttps_epi32(f);
+    i0 = _mm256_add_epi32(i0, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), i0), extent));
+    i1 = _mm256_add_epi32(i0, _mm256_set1_epi32(1));
+    i1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(i1, extent), i1);
+
+    return _mm256_sub_ps(p, f);
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto channel_x8(__m256i texel, int shift) -> __m256 {
+    auto bits = _mm256_srl_epi32(texel, _mm_cvtsi32_si128(shift));
+    return _mm256_cvtepi32_ps(_mm256_and_si256(bits, _mm256_set1_epi32(0xFF)));
+}
+
+CPP_ENGINE_TARGET_AVX2
+inline auto sample_bilinear_x8(Texture_View const& texture, __m256 u, __m256 v, __m256i mask) -> __m256i {
+    auto x0 = _mm256_setzero_si256(), x1 = x0, y0 = x0, y1 = x0;
+    auto ax = bilinear_axis_x8(u, texture.width, x0, x1);
+    auto ay = bilinear_axis_x8(v, texture.height, y0, y1);
+
+    auto c00 = gather_texels(texture, x0, y0, mask), c10 = gather_texels(texture, x1, y0, mask);
+    auto c01 = gather_texels(texture, x0, y1, mask), c11 = gather_texels(texture, x1, y1, mask);
+
+    auto texel = _mm256_setzero_si256();
+
+    for (auto shift = 0; shift < 32; shift += 8) {
+        auto a00 = channel_x8(c00, shift), a10 = channel_x8(c10, shift);
+        auto a01 = channel_x8(c01, shift), a11 = channel_x8(c11, shift);
+
+        auto top = _mm256_add_ps(a00, _mm256_mul_ps(_mm256_sub_ps(a10, a00), ax));
+        auto bottom = _mm256_add_ps(a01, _mm256_mul_ps(_mm256_sub_ps(a11, a01), ax));
+        auto value = _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), ay));
+
+        texel = _mm256_or_si256(texel, _mm256_sll_epi32(_mm256_cvtps_epi32(value), _mm_cvtsi32_si128(shift)));
+    }
+
+    return texel;
+}
+
+#endif
+
+} // namespace engine::details
+
+#endif //CPP_ENGINE_TEXTURE_SAMPLER_HPP
@@ -0,0 +1,71 @@
+#ifndef CPP_ENGINE_TEXTURE_UPLOAD_HPP
+#define CPP_ENGINE_TEXTURE_UPLOAD_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/Texture.hpp>
+
+#include "../pixel-buffer.hpp"
+
+namespace engine {
+
+/**
+ * Keeps a texture in sync with pixel buffers, only the tiles changed since the last update are sent.
+ * Rects spanning whole rows are uploaded in place, narrower ones go through a staging copy.
+ * Buffers may take turns on the same texture, what the shown one had drawn is sent again as well.
+ * */
+class Texture_Uploader {
+    std::vector<std::uint8_t> m_staging;
+    std::vector<std::uint8_t> m_shown; /* drawn tiles of the buffer last sent */
+    Basic_RGBA_Buffer const* m_last;
+    Basic_RGBA_Buffer::Pixel_Word m_background;
+
+public:
+    Texture_Uploader() :
+        m_staging(),
+        m_shown(),
+        m_last(nullptr),
+        m_background()
+    {}
+
+    auto update(sf::Texture & texture, Basic_RGBA_Buffer & pixels) -> void {
+        auto & dirty = pixels.dirty;
+
+        if (m_last != &pixels) {
+            if (std::size(m_shown) == std::size(dirty.pending) && m_background == pixels.clear_color) {
+                std::ranges::transform(dirty.pending, m_shown, std::begin(dirty.pending),
+                                       [](auto p, auto s) { return std::uint8_t(p | s); });
+            } else {
+                std::ranges::fill(dirty.pending, 1u);
+            }
+        }
+
+        dirty.upload_pending([this, &texture, &pixels](Clip_Rect const& rect) {
+            auto width = std::size_t(rect.x1 - rect.x0 + 1), height = std::size_t(rect.y1 - rect.y0 + 1);
+            auto source = std::data(pixels) + flat_index(rect.x0, rect.y0, pixels.width);
+
+            if (width == pixels.width) {
+                texture.update(source, unsigned(width), unsigned(height), 0u, unsigned(rect.y0));
+                return;
+            }
+
+            m_staging.resize(width * height * 4);
+
+            for (auto row = 0ul; row < height; ++row) {
+                std::copy_n(source + row * pixels.width * 4, width * 4, std::next(std::begin(m_staging), row * width * 4));
+            }
+
+            texture.update(std::data(m_staging), unsigned(width), unsigned(height), unsigned(rect.x0), unsigned(rect.y0));
+        });
+
+        m_shown = dirty.drawn;
+        m_last = &pixels;
+        m_background = pixels.clear_color;
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_TEXTURE_UPLOAD_HPP
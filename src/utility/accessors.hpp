@@ -3,16 +3,26 @@
 
 #include <type_traits>
 #include <array>
+#include <iterator>
 
-template <class Container, class Data_Accessor = decltype([]<class Obj>(Obj obj) -> auto& { return obj->container; })>
+/* Default accessor, the deriving type keeps its elements in a member named container */
+struct Member_Container_Accessor {
+    template <class Obj>
+    constexpr auto operator()(Obj obj) const noexcept -> auto& {
+        return obj->container;
+    }
+};
+
+template <class Container, class Data_Accessor = Member_Container_Accessor>
 struct Accessors_For {
 
 private:
-    inline constexpr auto get_container() noexcept -> auto& {
+    /* The accessor may hand back a reference to a member or a view by value, such as a span */
+    inline constexpr auto get_container() noexcept -> decltype(auto) {
         return Data_Accessor{}(static_cast<std::remove_const_t<Container>*>(this));
     }
 
-    inline constexpr auto get_container() const noexcept -> auto const& {
+    inline constexpr auto get_container() const noexcept -> decltype(auto) {
         return Data_Accessor{}(static_cast<std::add_const_t<Container>*>(this));
     }
 
@@ -21,6 +31,10 @@ public:
         return std::data(get_container());
     }
 
+    [[nodiscard]] inline constexpr auto data() const noexcept {
+        return std::data(get_container());
+    }
+
     [[nodiscard]] inline constexpr auto size() const noexcept {
         return std::size(get_container());
     }
@@ -0,0 +1,107 @@
+#ifndef CPP_ENGINE_BOUNDED_QUEUE_HPP
+#define CPP_ENGINE_BOUNDED_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace engine::util {
+
+/**
+ * Fixed capacity FIFO shared between threads.
+ * Producers block while it is full, consumers while it is empty, close() releases both.
+ * */
+template <class T>
+class Bounded_Queue {
+    std::deque<T> m_items;
+    std::size_t m_capacity;
+    bool m_closed;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+
+public:
+    explicit Bounded_Queue(std::size_t capacity) :
+        m_items(),
+        m_capacity(capacity),
+        m_closed(false)
+    {}
+
+    /* Blocks while full, false once closed */
+    auto push(T value) -> bool {
+        auto lock = std::unique_lock{ m_mutex };
+        m_not_full.wait(lock, [this] { return m_closed || std::size(m_items) < m_capacity; });
+
+        if (m_closed) {
+            return false;
+        }
+
+        m_items.push_back(std::move(value));
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /* False when full or closed, value is left untouched */
+    auto try_push(T & value) -> bool {
+        auto lock = std::unique_lock{ m_mutex };
+
+        if (m_closed || std::size(m_items) >= m_capacity) {
+            return false;
+        }
+
+        m_items.push_back(std::move(value));
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /* Blocks while empty, nullopt once closed and drained */
+    auto pop() -> std::optional<T> {
+        auto lock = std::unique_lock{ m_mutex };
+        m_not_empty.wait(lock, [this] { return m_closed || !std::empty(m_items); });
+
+        return take(lock);
+    }
+
+    auto try_pop() -> std::optional<T> {
+        auto lock = std::unique_lock{ m_mutex };
+
+        return take(lock);
+    }
+
+    auto close() -> void {
+        {
+            auto lock = std::lock_guard{ m_mutex };
+            m_closed = true;
+        }
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        auto lock = std::lock_guard{ m_mutex };
+        return std::size(m_items);
+    }
+
+private:
+    auto take(std::unique_lock<std::mutex> & lock) -> std::optional<T> {
+        if (std::empty(m_items)) {
+            return std::nullopt;
+        }
+
+        auto value = std::optional<T>{ std::move(m_items.front()) };
+        m_items.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return value;
+    }
+};
+
+}
+
+#endif //CPP_ENGINE_BOUNDED_QUEUE_HPP
@@ -0,0 +1,65 @@
+#ifndef CPP_ENGINE_CPU_HPP
+#define CPP_ENGINE_CPU_HPP
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define CPP_ENGINE_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#endif
+
+/* GCC and Clang only emit wider instructions inside functions that ask for them */
+#if defined(CPP_ENGINE_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define CPP_ENGINE_TARGET_SSE2 __attribute__((target("sse2")))
+    #define CPP_ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define CPP_ENGINE_TARGET_SSE2
+    #define CPP_ENGINE_TARGET_AVX2
+#endif
+
+namespace engine::cpu {
+
+struct Features {
+    bool sse2;
+    bool avx2;
+};
+
+namespace details {
+
+inline auto detect() -> Features {
+#if defined(CPP_ENGINE_X86) && defined(_MSC_VER) && !defined(__clang__)
+    auto info = std::array<int, 4>{};
+
+    __cpuid(std::data(info), 1);
+    auto sse2 = (info[3] & (1 << 26)) != 0;
+    auto os_avx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6; /* OSXSAVE and YMM state */
+
+    __cpuidex(std::data(info), 7, 0);
+    auto avx2 = os_avx && (info[1] & (1 << 5)) != 0;
+
+    return { sse2, avx2 };
+#elif defined(CPP_ENGINE_X86)
+    __builtin_cpu_init();
+    return {
+        __builtin_cpu_supports("sse2") != 0,
+        __builtin_cpu_supports("avx2") != 0
+    };
+#else
+    return {};
+#endif
+}
+
+} // namespace engine::cpu::details
+
+/* Detected once, on first use */
+inline auto features() -> Features const& {
+    static auto const detected = details::detect();
+    return detected;
+}
+
+} // namespace engine::cpu
+
+#endif //CPP_ENGINE_CPU_HPP